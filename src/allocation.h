@@ -0,0 +1,72 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_ALLOCATION_H_
+#define SRC_ALLOCATION_H_
+
+#include <utility>
+#include <vector>
+
+// Allocation yij between n bids and m asks, in which each bid gets at most
+// one ask and each ask is allocated to at most one bid. Stored as two match
+// arrays instead of an n x m matrix.
+class Allocation {
+ private:
+  std::vector<int> ask_of;  // ask allocated to each bid, -1 if none
+  std::vector<int> bid_of;  // bid each ask is allocated to, -1 if none
+
+ public:
+  Allocation() {}
+  Allocation(unsigned int n, unsigned int m) : ask_of(n, -1), bid_of(m, -1) {}
+
+  inline unsigned int N() const { return ask_of.size(); }
+  inline unsigned int M() const { return bid_of.size(); }
+
+  // yij
+  inline int operator()(unsigned int i, unsigned int j) const {
+    return ask_of[i] == (int)j;
+  }
+  inline int askOf(unsigned int i) const { return ask_of[i]; }
+  inline int bidOf(unsigned int j) const { return bid_of[j]; }
+
+  // sets yij = 1; bid i and ask j must be unallocated
+  inline void allocate(unsigned int i, unsigned int j) {
+    ask_of[i] = j;
+    bid_of[j] = i;
+  }
+  // sets yij = 0
+  inline void deallocate(unsigned int i, unsigned int j) {
+    ask_of[i] = -1;
+    bid_of[j] = -1;
+  }
+
+  // allocated pairs (i, j), by increasing bid index
+  std::vector<std::pair<int, int>> pairs() const {
+    std::vector<std::pair<int, int>> result;
+    for (unsigned int i = 0; i < ask_of.size(); ++i)
+      if (ask_of[i] >= 0) result.push_back(std::make_pair(i, ask_of[i]));
+    return result;
+  }
+
+  bool empty() const {
+    for (int j : ask_of)
+      if (j >= 0) return false;
+    return true;
+  }
+};
+
+#endif  // SRC_ALLOCATION_H_
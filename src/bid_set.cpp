@@ -16,69 +16,74 @@
 // --------------------------------------------------------------------------
 
 #include "src/bid_set.h"
-#include <boost/numeric/ublas/matrix_proxy.hpp>
 
-BidSet::BidSet(const std::vector<double> &v_v,
-               const boost::numeric::ublas::matrix<int> &m_q)
-    : values(v_v), quantities(m_q) {}
-
-BidSet::BidSet(const BidSet &copy)
-    : values(copy.values), quantities(copy.quantities) {}
-
-BidSet BidSet::fromYAML(YAML::Node bidset) {
-  auto values = bidset["values"].as<std::vector<double>>();
-
-  std::vector<unsigned int> v_q;
-  for (auto row : bidset["quantities"]) {
-    auto v_row = row.as<std::vector<unsigned int>>();
-    v_q.insert(v_q.end(), v_row.begin(), v_row.end());
-  }
-
-  auto nrows = bidset["quantities"].size();
-  auto ncols = v_q.size() / nrows;
+#include <algorithm>
+#include <stdexcept>
 
-  boost::numeric::ublas::matrix<unsigned int> quantities(nrows, ncols);
-  std::copy(v_q.begin(), v_q.end(), quantities.data().begin());
+namespace {
 
-  return BidSet(values, quantities);
+// zero-initialized aligned rows of quantities
+std::shared_ptr<unsigned int> allocateRows(unsigned long count) {
+  unsigned int *rows = AlignedAllocator<unsigned int>().allocate(count);
+  std::fill_n(rows, count, 0);
+  return std::shared_ptr<unsigned int>(rows, [count](unsigned int *p) {
+    AlignedAllocator<unsigned int>().deallocate(p, count);
+  });
 }
 
-BidSet BidSet::sample(double sampling_ratio) {
-  unsigned int sample_n = (int)(N() * sampling_ratio);
+}  // namespace
 
-  std::vector<double> sample_values;
-  sample_values.resize(sample_n);
-  std::copy_n(values.begin(), sample_n, sample_values.begin());
+BidSet::BidSet(const std::vector<double> &v_v,
+               const boost::numeric::ublas::matrix<int> &m_q)
+    : values(v_v), n(m_q.size1()), l(m_q.size2()), stride(paddedLength(l)) {
+  auto r_q = allocateRows((unsigned long)n * stride);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int k = 0; k < l; ++k) r_q.get()[i * stride + k] = m_q(i, k);
+  rows = r_q;
+}
 
-  auto sample_quantities =
-      boost::numeric::ublas::subslice(quantities, 0, 1, sample_n, 0, 1, L());
+BidSet::BidSet(const std::vector<double> &v_v,
+               std::shared_ptr<const unsigned int> r_q, unsigned int l_)
+    : values(v_v), n(v_v.size()), l(l_), stride(paddedLength(l_)), rows(r_q) {}
 
-  return BidSet(sample_values, sample_quantities);
+BidSet::BidSet(const BidSet &copy)
+    : values(copy.values),
+      n(copy.n),
+      l(copy.l),
+      stride(copy.stride),
+      rows(copy.rows) {}
+
+// The first bids (or asks) of the set; they share the rows of the set.
+BidSet BidSet::sample(double sampling_ratio) const {
+  unsigned int sample_n = (int)(N() * sampling_ratio);
+  std::vector<double> sample_values(values.begin(),
+                                    values.begin() + sample_n);
+  return BidSet(sample_values, rows, l);
 }
 
-boost::unordered_map<unsigned int, double> BidSet::computeAvgPrices() const {
-  boost::unordered_map<unsigned int, double> avg_price;
+std::vector<double> BidSet::computeAvgPrices() const {
+  std::vector<double> avg_price(N());
   for (unsigned int i = 0; i < N(); ++i) {
     unsigned int q_i = 0;
     for (unsigned int k = 0; k < L(); ++k) {
-      q_i += quantities(i, k);
+      q_i += row(i)[k];
     }
     avg_price[i] = values[i] / q_i;
   }
   return avg_price;
 }
 
-boost::unordered_map<unsigned int, double> BidSet::computeDensities() const {
+std::vector<double> BidSet::computeDensities() const {
   return computeDensities(std::vector<double>(L(), 1.));
 }
 
-boost::unordered_map<unsigned int, double> BidSet::computeDensities(
-    std::vector<double> f) const {
-  boost::unordered_map<unsigned int, double> density;
+std::vector<double> BidSet::computeDensities(
+    const std::vector<double> &f) const {
+  std::vector<double> density(N());
   for (unsigned int i = 0; i < N(); ++i) {
     double m_i = 0;
     for (unsigned int k = 0; k < L(); ++k) {
-      m_i += quantities(i, k) * f[k];
+      m_i += row(i)[k] * f[k];
     }
     density[i] = values[i] / std::sqrt(m_i);
   }
@@ -89,7 +94,7 @@ std::vector<unsigned int> BidSet::computeQPerResource() const {
   std::vector<unsigned int> qpr(L(), 0);
   for (unsigned int i = 0; i < N(); ++i) {
     for (unsigned int k = 0; k < L(); ++k) {
-      qpr[k] += quantities(i, k);
+      qpr[k] += row(i)[k];
     }
   }
   return qpr;
@@ -18,33 +18,71 @@
 #ifndef SRC_BID_SET_H_
 #define SRC_BID_SET_H_
 
-#include <yaml-cpp/yaml.h>
 #include <boost/numeric/ublas/matrix.hpp>
-#include <boost/unordered_map.hpp>
+#include <memory>
 #include <vector>
 
+#include "src/dominance.h"
+
+// read-only N x L view of the quantities of a bid set
+class QuantityMatrix {
+ private:
+  const unsigned int *rows;
+  unsigned int stride, n, l;
+
+ public:
+  QuantityMatrix(const unsigned int *rows_, unsigned int stride_,
+                 unsigned int n_, unsigned int l_)
+      : rows(rows_), stride(stride_), n(n_), l(l_) {}
+
+  inline unsigned int size1() const { return n; }
+  inline unsigned int size2() const { return l; }
+  inline unsigned int operator()(unsigned int i, unsigned int k) const {
+    return rows[i * stride + k];
+  }
+};
+
 class BidSet {
  protected:
   std::vector<double> values;
-  boost::numeric::ublas::matrix<unsigned int> quantities;
+  unsigned int n = 0;
+  unsigned int l = 0;
+  // quantities as aligned rows padded with zeros for SIMD kernels; they are
+  // never modified, and shared between copies (e.g. mapped from a file)
+  unsigned int stride = 0;
+  std::shared_ptr<const unsigned int> rows;
 
  public:
   BidSet(const std::vector<double> &v_v,
          const boost::numeric::ublas::matrix<int> &m_q);  // generic constructor
+  // @param r_q padded rows of quantities, with stride paddedLength(l_)
+  BidSet(const std::vector<double> &v_v,
+         std::shared_ptr<const unsigned int> r_q, unsigned int l_);
   BidSet(const BidSet &copy);                             // copy constructor
   BidSet() {}                                             // default constructor
-  static BidSet fromYAML(YAML::Node bidset);
-  BidSet sample(double sampling_ratio);
+  BidSet sample(double sampling_ratio) const;
 
-  inline unsigned int N() const { return quantities.size1(); }
-  inline unsigned int L() const { return quantities.size2(); }
+  inline unsigned int N() const { return n; }
+  inline unsigned int L() const { return l; }
   inline const auto &V() const { return values; }
-  inline const auto &Q() const { return quantities; }
+  inline QuantityMatrix Q() const {
+    return QuantityMatrix(rows.get(), stride, n, l);
+  }
+  inline unsigned int S() const { return stride; }  // padded row length
+  inline const unsigned int *row(unsigned int i) const {
+    return rows.get() + i * stride;
+  }
+
+  // bytes of values and quantities, shared rows included
+  inline std::size_t memoryUsage() const {
+    return values.size() * sizeof(double) +
+           (std::size_t)n * stride * sizeof(unsigned int);
+  }
 
-  boost::unordered_map<unsigned int, double> computeAvgPrices() const;
-  boost::unordered_map<unsigned int, double> computeDensities() const;
-  boost::unordered_map<unsigned int, double> computeDensities(
-      std::vector<double> f) const;
+  // values indexed by bid (or ask) index
+  std::vector<double> computeAvgPrices() const;
+  std::vector<double> computeDensities() const;
+  std::vector<double> computeDensities(const std::vector<double> &f) const;
   std::vector<unsigned int> computeQPerResource() const;
 };
 
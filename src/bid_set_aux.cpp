@@ -17,12 +17,17 @@
 
 #include "src/bid_set_aux.h"
 
-BidSetAux::BidSetAux(BidSet bidset)
+BidSetAux::BidSetAux(const BidSet &bidset)
     : f(bidset.L(), 1.),
       avg_price(bidset.computeAvgPrices()),
       density(bidset.computeDensities()) {}
 
-BidSetAux::BidSetAux(BidSet bidset, std::vector<double> _f)
+BidSetAux::BidSetAux(const BidSet &bidset, std::vector<double> _f)
     : f(_f),
       avg_price(bidset.computeAvgPrices()),
-      density(bidset.computeDensities(_f)) {}
\ No newline at end of file
+      density(bidset.computeDensities(_f)) {}
+
+BidSetAux::BidSetAux(const BidSetAux &full, unsigned int n)
+    : f(full.f),
+      avg_price(full.avg_price.begin(), full.avg_price.begin() + n),
+      density(full.density.begin(), full.density.begin() + n) {}
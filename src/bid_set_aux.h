@@ -18,24 +18,25 @@
 #ifndef SRC_BID_SET_AUX_H_
 #define SRC_BID_SET_AUX_H_
 
-#include <boost/unordered_map.hpp>
 #include <vector>
 
 #include "src/bid_set.h"
 
 class BidSetAux {
  protected:
-  std::vector<double> f;                                 // relevance factors
-  boost::unordered_map<unsigned int, double> avg_price;  // average prices
-  boost::unordered_map<unsigned int, double> density;    // densities
+  std::vector<double> f;          // relevance factors
+  std::vector<double> avg_price;  // average prices, by index
+  std::vector<double> density;    // densities, by index
 
  public:
   BidSetAux() {}
-  BidSetAux(BidSet bidset);
-  BidSetAux(BidSet bidset, std::vector<double> _f);
+  BidSetAux(const BidSet &bidset);
+  BidSetAux(const BidSet &bidset, std::vector<double> _f);
+  // values of the first n bids (or asks) of a set, e.g. of a sample
+  BidSetAux(const BidSetAux &full, unsigned int n);
 
-  inline boost::unordered_map<unsigned int, double> &getDensity() { return density; }
-  inline boost::unordered_map<unsigned int, double> &getAvgPrice() { return avg_price; }
+  inline const std::vector<double> &getDensity() const { return density; }
+  inline const std::vector<double> &getAvgPrice() const { return avg_price; }
 };
 
 #endif  // SRC_BID_SET_AUX_H_
\ No newline at end of file
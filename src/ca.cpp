@@ -21,28 +21,35 @@
 #include <boost/numeric/ublas/io.hpp>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <utility>
+
+#include "src/vcg_pricing.h"
 
 using Time = boost::posix_time::ptime;
 using TimeDuration = boost::posix_time::time_duration;
 
 // init f_a and f_b attributes to 1 by default
-CA::CA(Instance _instance)
-    : instance(_instance),
-      tmp_bids(BidSetAux(instance.getBids())),
-      tmp_asks(BidSetAux(instance.getAsks())),
-      x(_instance.getBids().N(), 0),
-      y(_instance.getBids().N(), _instance.getAsks().N()) {}
-
-CA::CA(Instance _instance, RelevanceMode mode)
-    : instance(_instance),
-      x(_instance.getBids().N(), 0),
-      y(_instance.getBids().N(), _instance.getAsks().N()) {
+CA::CA(InstancePtr _instance)
+    : instance_ptr(_instance),
+      instance(*instance_ptr),
+      tmp_bids(instance.getBidsAux()),
+      tmp_asks(instance.getAsksAux()),
+      x(_instance->getBids().N(), 0),
+      y(_instance->getBids().N(), _instance->getAsks().N()) {}
+
+CA::CA(InstancePtr _instance, RelevanceMode mode)
+    : instance_ptr(_instance),
+      instance(*instance_ptr),
+      x(_instance->getBids().N(), 0),
+      y(_instance->getBids().N(), _instance->getAsks().N()) {
   std::vector<double> f_b, f_a;
   switch (mode) {
     case RelevanceMode::UNIFORM: {
-      f_b = std::vector<double>(instance.L(), 1.);
-      f_a = std::vector<double>(instance.L(), 1.);
-      break;
+      // precomputed by the instance
+      tmp_bids = instance.getBidsAux();
+      tmp_asks = instance.getAsksAux();
+      return;
     }
     case RelevanceMode::SCARCITY: {
       auto capacity = instance.getAsks().computeQPerResource();
@@ -77,20 +84,29 @@ void CA::run() {
   Time t1(boost::posix_time::microsec_clock::local_time());
   long usec = (t1 - t0).total_microseconds();
   // compute pricing and stats
-  computeKPricing(0.5);
+  if (pricing == +PricingMode::VCG)
+    computeVCGPricing();
+  else
+    computeKPricing(0.5);
   computeStatistics();
   stats.setTimeWdp(usec / 1000.);
 }
 
 void CA::resetAllocation() { resetBase(); }
 
+// @return the seed for the random generator of the current run
+unsigned long CA::nextSeed() {
+  if (seed) return *seed;
+  std::random_device rd;
+  return rd();
+}
+
 bool CA::noSideEffects() { return noSideEffectsBase(); }
 
 void CA::resetBase() {
   // reset variables if new allocation must be calculated
   x = std::vector<int>(instance.getBids().N(), 0);
-  y = boost::numeric::ublas::zero_matrix<int>(instance.getBids().N(),
-                                              instance.getAsks().N());
+  y = Allocation(instance.getBids().N(), instance.getAsks().N());
 
   bid_index = std::vector<int>();
   ask_index = std::vector<int>();
@@ -116,11 +132,10 @@ bool CA::noSideEffectsBase() {
   for (unsigned int i = 0; i < instance.getBids().N(); ++i) {
     if (x[i]) return false;
     if (price_buyer[i]) return false;
-    for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-      if (y(i, j)) return false;
-      if (price_seller[j]) return false;
-    }
   }
+  for (unsigned int j = 0; j < instance.getAsks().N(); ++j)
+    if (price_seller[j]) return false;
+  if (!y.empty()) return false;
   if (!std::is_sorted(bid_index.begin(), bid_index.end())) return false;
   if (!std::is_sorted(ask_index.begin(), ask_index.end())) return false;
 
@@ -135,17 +150,29 @@ bool CA::noSideEffectsBase() {
 void CA::computeKPricing(double kappa) {
   // compute prices
   for (unsigned int i = 0; i < instance.getBids().N(); ++i) {
-    for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-      if (y(i, j) > 0) {
-        price_buyer[i] = instance.getAsks().V()[j] * kappa +
-                         instance.getBids().V()[i] * (1 - kappa);
-        price_seller[j] = price_buyer[i];
-        break;
-      }
+    int j = y.askOf(i);
+    if (j >= 0) {
+      price_buyer[i] = instance.getAsks().V()[j] * kappa +
+                       instance.getBids().V()[i] * (1 - kappa);
+      price_seller[j] = price_buyer[i];
     }
   }
 }
 
+// Payments of the winners with respect to the allocation, see VCGPricing.
+void CA::computeVCGPricing() {
+  std::vector<std::pair<int, int>> pairs;
+  for (unsigned int i = 0; i < instance.getBids().N(); ++i) {
+    int j = y.askOf(i);
+    if (j >= 0) pairs.push_back({i, j});
+  }
+  VCGPricing vcg(instance, pairs, num_threads);
+  for (unsigned int k = 0; k < pairs.size(); ++k) {
+    price_buyer[pairs[k].first] = vcg.buyerPrice(k);
+    price_seller[pairs[k].second] = vcg.sellerPrice(k);
+  }
+}
+
 void CA::computeStatistics() {
   // return welfare / (n + m);
   // only consider winners in calculations
@@ -167,12 +194,10 @@ void CA::computeStatistics() {
         num_goods_traded += instance.getBids().Q()(i, k);
       }
       // sellers
-      for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-        if (y(i, j) > 0) {
-          welfare += (price_seller[j] - instance.getAsks().V()[j]);
-          ++num_winners;
-          break;
-        }
+      int j = y.askOf(i);
+      if (j >= 0) {
+        welfare += (price_seller[j] - instance.getAsks().V()[j]);
+        ++num_winners;
       }
     }
   }
@@ -187,13 +212,11 @@ void CA::computeStatistics() {
             (instance.getBids().V()[i] - price_buyer[i] - mean_utility) *
             (instance.getBids().V()[i] - price_buyer[i] - mean_utility);
         // sellers
-        for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-          if (y(i, j) > 0) {
-            stddev_utility +=
-                (price_seller[j] - instance.getAsks().V()[j] - mean_utility) *
-                (price_seller[j] - instance.getAsks().V()[j] - mean_utility);
-            break;
-          }
+        int j = y.askOf(i);
+        if (j >= 0) {
+          stddev_utility +=
+              (price_seller[j] - instance.getAsks().V()[j] - mean_utility) *
+              (price_seller[j] - instance.getAsks().V()[j] - mean_utility);
         }
       }
     }
@@ -19,11 +19,14 @@
 #define SRC_CA_H_
 
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/optional.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
+#include "src/allocation.h"
 #include "src/bid_set_aux.h"
 #include "src/helper.h"
 #include "src/instance.h"
@@ -31,8 +34,9 @@
 
 class CA {
  protected:
-  // problem instance (a set of bids and asks)
-  Instance instance;
+  // problem instance (a set of bids and asks), shared with other algorithms
+  InstancePtr instance_ptr;
+  const Instance &instance;
 
   // auxiliary structs
   BidSetAux tmp_bids;
@@ -43,17 +47,26 @@ class CA {
   std::vector<int> ask_index;
 
   // output of allocation and pricing
-  std::vector<int> x;                    // xi
-  boost::numeric::ublas::matrix<int> y;  // yij
+  std::vector<int> x;  // xi
+  Allocation y;        // yij
   boost::unordered_map<int, double> price_buyer;
   boost::unordered_map<int, double> price_seller;
 
   // statistics
   Stats stats;
 
+  // seed of the random generator of stochastic algorithms, if set
+  boost::optional<unsigned long> seed;
+
+  // pricing of the winners after the allocation
+  PricingMode pricing = PricingMode::K;
+
+  // threads a run may use, including the calling one
+  unsigned int num_threads = 1;
+
  public:
-  CA(Instance _instance);
-  CA(Instance _instance, RelevanceMode mode);
+  CA(InstancePtr _instance);
+  CA(InstancePtr _instance, RelevanceMode mode);
   virtual ~CA(){};
 
   const auto &getAllocation() { return y; }
@@ -62,6 +75,15 @@ class CA {
   const auto getStats() { return stats; }
 
   void run();
+  // all following runs use this seed; by default, each run of a stochastic
+  // algorithm draws its seed from std::random_device
+  void setSeed(unsigned long seed_) { seed = seed_; }
+  // by default, the winners pay k-prices with k = 0.5
+  void setPricing(PricingMode pricing_) { pricing = pricing_; }
+  // by default, a run is single-threaded
+  void setThreads(unsigned int num_threads_) {
+    num_threads = std::max(1u, num_threads_);
+  }
   void printResults(std::string mechanism_name);
   virtual void resetAllocation();  // can be overwritten to reset all tmp vars
   virtual bool noSideEffects();
@@ -71,7 +93,9 @@ class CA {
   virtual void computeAllocation() = 0;  // WDP to be overwritten for each
                                          // implemented mechanism
   virtual void computeKPricing(double kappa);
+  virtual void computeVCGPricing();
   void resetBase();
+  unsigned long nextSeed();
   bool noSideEffectsBase();
 };
 
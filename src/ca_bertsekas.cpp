@@ -0,0 +1,226 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "ca_bertsekas.h"
+
+#include <algorithm>
+#include <limits>
+
+CABertsekas::CABertsekas(InstancePtr instance_, double epsilon_)
+    : CA(instance_), epsilon(epsilon_) {}
+
+CABertsekas::~CABertsekas() {}
+
+void CABertsekas::computeAllocation() {
+  unsigned int n = instance.getBids().N();
+  unsigned int m = instance.getAsks().N();
+
+  match_bid = std::vector<int>(n, -1);
+  match_ask = std::vector<int>(m, -1);
+  price = std::vector<double>(m, 0.);
+
+  compatible_asks = instance.computeCompatibleAsks();
+  compatible_bids = std::vector<std::vector<int>>(m);
+  for (unsigned int i = 0; i < n; ++i)
+    for (int j : compatible_asks[i]) compatible_bids[j].push_back(i);
+
+  // maximum welfare of a pair, which bounds the optimal welfare from below
+  double max_weight = 0.;
+  for (unsigned int i = 0; i < n; ++i)
+    for (int j : compatible_asks[i])
+      max_weight = std::max(max_weight, weight(i, j));
+  if (max_weight <= 0.) return;
+
+  // the final assignment is within n * eps_min of the optimal welfare
+  double eps_min = epsilon * max_weight / n;
+  double eps = std::max(eps_min, max_weight / theta);
+
+  // the calling thread takes part in the bidding phase
+  ThreadPool pool(num_threads - 1);
+  while (true) {
+    // keep the prices, and the allocated bids that are still within eps of
+    // their best profit (eps-complementary slackness)
+    for (unsigned int i = 0; i < n; ++i) {
+      if (match_bid[i] < 0) continue;
+      double best = 0.;
+      for (int j : compatible_asks[i])
+        best = std::max(best, weight(i, j) - price[j]);
+      if (profit(i) < best - eps) {
+        match_ask[match_bid[i]] = -1;
+        match_bid[i] = -1;
+      }
+    }
+    forwardAuction(eps, pool);
+    reverseAuction(eps);
+    if (eps <= eps_min) break;
+    eps = std::max(eps_min, eps / theta);
+  }
+
+  for (unsigned int i = 0; i < n; ++i) {
+    if (match_bid[i] >= 0) {
+      x[i] = 1;
+      y.allocate(i, match_bid[i]);
+    }
+  }
+}
+
+// Forward auction: repeats rounds until every bid is either allocated or
+// prefers to stay unallocated at the current prices.
+// @param eps minimum price increment
+// @param pool threads computing the bids of a round
+void CABertsekas::forwardAuction(double eps, ThreadPool &pool) {
+  unsigned int n = instance.getBids().N();
+
+  std::vector<int> active;
+  for (unsigned int i = 0; i < n; ++i)
+    if (match_bid[i] < 0 && !compatible_asks[i].empty()) active.push_back(i);
+
+  std::vector<int> target(n, -1);
+  std::vector<double> offer(n, 0.);
+  std::vector<double> seen(n, 0.);  // price of the target when bidding
+
+  while (!active.empty()) {
+    // bidding phase: the prices are only read, so bids run concurrently
+    pool.parallelFor(0, active.size(), [&](unsigned int k) {
+      int i = active[k];
+      target[i] = computeBid(i, eps, offer[i]);
+      if (target[i] >= 0) seen[i] = price[target[i]];
+    }, grain);
+
+    // assignment phase: bids are applied in order; a bid for an ask taken
+    // earlier in this round is recomputed, since prices have changed (other
+    // prices only increased, so all remaining bids are still valid)
+    std::vector<int> next_active;
+    for (int i : active) {
+      int j = target[i];
+      if (j >= 0 && price[j] != seen[i]) j = computeBid(i, eps, offer[i]);
+      if (j < 0) continue;
+      // the previous owner is outbid and becomes unallocated
+      if (match_ask[j] >= 0) {
+        match_bid[match_ask[j]] = -1;
+        next_active.push_back(match_ask[j]);
+      }
+      match_ask[j] = i;
+      match_bid[i] = j;
+      price[j] = offer[i];
+    }
+    active.swap(next_active);
+  }
+}
+
+// Computes the bid of bid i for its best ask at the current prices.
+// @param i the index of the bid
+// @param eps minimum price increment
+// @param offer the price offered for the returned ask
+// @return the ask bid for, or -1 if bid i prefers to stay unallocated
+int CABertsekas::computeBid(unsigned int i, double eps, double &offer) {
+  // staying unallocated is always possible and worth 0
+  double v1 = 0., v2 = 0.;
+  int j1 = -1;
+  for (int j : compatible_asks[i]) {
+    double v = weight(i, j) - price[j];
+    if (v > v1) {
+      v2 = v1;
+      v1 = v;
+      j1 = j;
+    } else if (v > v2) {
+      v2 = v;
+    }
+  }
+  if (j1 >= 0) offer = price[j1] + v1 - v2 + eps;
+  return j1;
+}
+
+// Reverse auction: unallocated asks with a positive price lower their price
+// to attract a bid, until all unallocated asks have price 0.
+// @param eps minimum profit increment of the attracted bid
+void CABertsekas::reverseAuction(double eps) {
+  unsigned int m = instance.getAsks().N();
+
+  std::vector<int> queue;
+  for (unsigned int j = 0; j < m; ++j)
+    if (match_ask[j] < 0 && price[j] > 0.) queue.push_back(j);
+
+  while (!queue.empty()) {
+    int j = queue.back();
+    queue.pop_back();
+
+    // find the best and second best bid for ask j
+    double beta = -std::numeric_limits<double>::infinity();
+    double omega = -std::numeric_limits<double>::infinity();
+    int best = -1;
+    for (int i : compatible_bids[j]) {
+      double v = weight(i, j) - profit(i);
+      if (v > beta) {
+        omega = beta;
+        beta = v;
+        best = i;
+      } else if (v > omega) {
+        omega = v;
+      }
+    }
+
+    // ask j cannot attract any bid => it stays unallocated at price 0
+    if (best < 0 || beta - eps <= 0.) {
+      price[j] = 0.;
+      continue;
+    }
+
+    price[j] = std::max(0., omega - eps);
+    int old_j = match_bid[best];
+    match_bid[best] = j;
+    match_ask[j] = best;
+    if (old_j >= 0) {
+      match_ask[old_j] = -1;
+      if (price[old_j] > 0.) queue.push_back(old_j);
+    }
+  }
+}
+
+// welfare of allocating ask j to bid i
+// @param i the index of the bid
+// @param j the index of the ask
+// @return welfare
+double CABertsekas::weight(unsigned int i, unsigned int j) {
+  return instance.getBids().V()[i] - instance.getAsks().V()[j];
+}
+
+// profit of bid i at the current prices, 0 if unallocated
+// @param i the index of the bid
+// @return profit
+double CABertsekas::profit(unsigned int i) {
+  if (match_bid[i] < 0) return 0.;
+  return weight(i, match_bid[i]) - price[match_bid[i]];
+}
+
+void CABertsekas::resetAllocation() {
+  resetBase();
+  compatible_asks = std::vector<std::vector<int>>();
+  compatible_bids = std::vector<std::vector<int>>();
+  match_bid = std::vector<int>();
+  match_ask = std::vector<int>();
+  price = std::vector<double>();
+}
+
+bool CABertsekas::noSideEffects() {
+  if (!compatible_asks.empty()) return false;
+  if (!compatible_bids.empty()) return false;
+  if (!match_bid.empty()) return false;
+  if (!match_ask.empty()) return false;
+  if (!price.empty()) return false;
+  return noSideEffectsBase();
+}
@@ -0,0 +1,70 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_CA_BERTSEKAS_H_
+#define SRC_CA_BERTSEKAS_H_
+
+#include <vector>
+
+#include "src/ca.h"
+#include "src/thread_pool.h"
+
+// Auction algorithm of Bertsekas for the WDP seen as an asymmetric
+// assignment problem (bids may stay unallocated), with epsilon-scaling.
+// Each scaling phase runs a forward auction, in which all unallocated bids
+// compute their bids concurrently, followed by a reverse auction in which
+// unallocated asks with a positive price bid for bids.
+// The welfare is at most epsilon * (maximum welfare of a pair) below optimum.
+class CABertsekas : public CA {
+ public:
+  static constexpr double default_epsilon = 1e-3;
+
+  CABertsekas(InstancePtr instance_, double epsilon_ = default_epsilon);
+  ~CABertsekas();
+
+  // ask prices at the end of the auction (dual variables of the asks)
+  const auto &getAskPrices() { return price; }
+
+  bool noSideEffects();
+  void resetAllocation();
+
+ private:
+  void computeAllocation();
+  void forwardAuction(double eps, ThreadPool &pool);
+  void reverseAuction(double eps);
+  int computeBid(unsigned int i, double eps, double &offer);
+  inline double weight(unsigned int i, unsigned int j);
+  inline double profit(unsigned int i);
+
+  // compatible asks of each bid, and compatible bids of each ask
+  std::vector<std::vector<int>> compatible_asks;
+  std::vector<std::vector<int>> compatible_bids;
+
+  // accuracy of the final scaling phase, relative to the optimal welfare
+  const double epsilon;
+  // factor by which epsilon is reduced between scaling phases
+  const double theta = 5.;
+  // minimum number of bids handled by a thread during the bidding phase
+  const unsigned int grain = 64;
+
+  // current assignment and ask prices
+  std::vector<int> match_bid;
+  std::vector<int> match_ask;
+  std::vector<double> price;
+};
+
+#endif  // SRC_CA_BERTSEKAS_H_
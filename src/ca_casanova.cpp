@@ -17,13 +17,14 @@
 
 #include "ca_casanova.h"
 
-CACasanova::CACasanova(Instance instance_)
+CACasanova::CACasanova(InstancePtr instance_)
     : CA(instance_),
-      maxSteps(instance_.getBids().N()),
-      theta(instance_.getBids().N() / 4),
-      distribution_neighbor(0, instance_.getBids().N() - 1),
-      distribution_wp(0.0, 1.0),
-      distribution_np(0.0, 1.0) {
+      maxSteps(instance_->getBids().N()),
+      theta(instance_->getBids().N() / 4) {}
+
+CACasanova::~CACasanova() {}
+
+void CACasanova::computeAllocation() {
   // init sorted bids
   for (unsigned int i = 0; i < instance.getBids().N(); ++i)
     bids_sorted.push_back(i);
@@ -32,6 +33,9 @@ CACasanova::CACasanova(Instance instance_)
             [&](unsigned int i, unsigned int j) -> bool {
               return tmp_bids.getAvgPrice()[i] > tmp_bids.getAvgPrice()[j];
             });
+  bid_position.resize(bids_sorted.size());
+  for (unsigned int p = 0; p < bids_sorted.size(); ++p)
+    bid_position[bids_sorted[p]] = p;
   // init sorted asks
   for (unsigned int j = 0; j < instance.getAsks().N(); ++j)
     asks_sorted.push_back(j);
@@ -40,147 +44,144 @@ CACasanova::CACasanova(Instance instance_)
             [&](unsigned int i, unsigned int j) -> bool {
               return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
             });
-}
+  compatible_asks = instance.orderedCompatibility(true, asks_sorted);
+
+  // the generators of the tries are seeded from one seeded with rd(), unless
+  // a seed was set
+  std::mt19937_64 generator(nextSeed());
+  std::vector<Try> tries(maxTries);
+  for (auto &t : tries) t.generator.seed(generator());
+
+  // the calling thread runs a try too
+  ThreadPool pool(std::min(num_threads, maxTries) - 1);
+  pool.parallelFor(0, maxTries, [&](unsigned int k) { search(tries[k]); });
+
+  // the first best try, as if they had run one after the other
+  for (auto &t : tries) {
+    if (t.welfare > best_welfare) {
+      best_welfare = t.welfare;
+      best_bid_of = t.bid_of;
+    }
+  }
 
-CACasanova::~CACasanova() {}
+  for (unsigned int j = 0; j < best_bid_of.size(); ++j) {
+    if (best_bid_of[j] < 0) continue;
+    x[best_bid_of[j]] = 1;
+    y.allocate(best_bid_of[j], j);
+  }
+}
 
-void CACasanova::computeAllocation() {
-  // reset random generator
-  std::random_device rd;
-  generator.seed(rd());
-
-  for (unsigned int tries = 0; tries < maxTries; ++tries) {
-    resetBetweenTries();
-
-    for (era = 0, last_improved_era = 0;
-         era < maxSteps && bid_index.size() && ask_index.size() &&
-         (era < theta || era - last_improved_era < theta / 2);
-         ++era) {
-      if (distribution_wp(generator) < wp) {
-        // allocate a random bid
-        unsigned int i = distribution_neighbor(generator) % bid_index.size();
-        insert(i);
+// Runs a try from the empty allocation.
+void CACasanova::search(Try &t) {
+  std::uniform_int_distribution<> distribution_neighbor(
+      0, instance.getBids().N() - 1);
+  std::uniform_real_distribution<> distribution_wp(0.0, 1.0);
+  std::uniform_real_distribution<> distribution_np(0.0, 1.0);
+
+  resetBetweenTries(t);
+  for (t.era = 0, t.last_improved_era = 0;
+       t.era < maxSteps && t.unallocated_bids.size() && t.num_free_asks &&
+       (t.era < theta || t.era - t.last_improved_era < theta / 2);
+       ++t.era) {
+    if (distribution_wp(t.generator) < wp) {
+      // allocate a random bid
+      unsigned int r =
+          distribution_neighbor(t.generator) % t.unallocated_bids.size();
+      insert(t, r);
+    } else {
+      if (t.unallocated_bids.size() == 1 ||
+          age(t, unallocatedBid(t, 0)) > age(t, unallocatedBid(t, 1))) {
+        insert(t, 0);
       } else {
-        if (bid_index.size() == 1 || age(bid_index[0]) > age(bid_index[1])) {
-          insert(0);
+        if (distribution_np(t.generator) < np) {
+          insert(t, 1);
         } else {
-          if (distribution_np(generator) < np) {
-            insert(1);
-          } else {
-            insert(0);
-          }
+          insert(t, 0);
         }
       }
     }
-    if (welfare > best_welfare) {
-      best_welfare = welfare;
-      best_allocated_asks = allocated_asks;
-    }
-  }
-
-  welfare = best_welfare;
-  for (auto it : best_allocated_asks) {
-    x[it.second] = 1;
-    y(it.second, it.first) = 1;
   }
 }
 
 // Allocates the given bid (if possible).
-// @param i the bid index in the list of unallocated bids 'bids'
-void CACasanova::insert(unsigned int i) {
+// @param r the rank of the bid among the unallocated bids, in the order of
+// bids_sorted
+void CACasanova::insert(Try &t, unsigned int r) {
+  unsigned int p = t.unallocated_bids.select(r);
+  int i = bids_sorted[p];
   // look for a seller in the list of unallocated asks
-  unsigned int j = 0;
-  while (j < ask_index.size()) {
-    // seller j can allocate resources to bidder i
-    if (instance.canAllocate(bid_index[i], ask_index[j])) {
-      welfare += instance.getBids().V()[bid_index[i]] -
-                 instance.getAsks().V()[ask_index[j]];
-      last_improved_era = era;
-      allocated_asks[ask_index[j]] = bid_index[i];
-      ask_index.erase(ask_index.begin() + j);
-      // update bid birthday
-      birthday[bid_index[i]] = era;
-      // remove from lists of
-      bid_index.erase(bid_index.begin() + i);
-      return;
-    }
-    ++j;
+  unsigned int q = compatible_asks->first(i, t.free_asks);
+  if (q < compatible_asks->size()) {
+    int j = compatible_asks->at(q);
+    t.welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+    t.last_improved_era = t.era;
+    t.bid_of[j] = i;
+    compatible_asks->toggle(t.free_asks, j);
+    t.matched_value.set(q, instance.getBids().V()[i]);
+    --t.num_free_asks;
+    // update bid birthday
+    t.birthday[i] = t.era;
+    // remove from list of unallocated bids
+    t.unallocated_bids.erase(p);
+    return;
   }
-  // return;
-  // if no seller could be found, look for one that has already allocated
-  // its bundle, but would gain more by switching to this bidder
-  for (auto it : allocated_asks) {
-    j = it.first;
-    if (instance.canAllocate(bid_index[i], j)) {
-      // check which bidder it already allocated goods to
-      unsigned int alloc_i = it.second;
-
-      // change from alloc_i to bid_index[i] only if there is an increase in
-      // revenue
-      if (instance.getBids().V()[alloc_i] <
-          instance.getBids().V()[bid_index[i]]) {
-        allocated_asks[j] = bid_index[i];
-        welfare += instance.getBids().V()[bid_index[i]] -
-                   instance.getBids().V()[alloc_i];
-        last_improved_era = era;
-        // update bid birthday
-        birthday[bid_index[i]] = era;
-        // once this bid was allocated, remove from list of unallocated bids
-        bid_index.erase(bid_index.begin() + i);
-        // insert alloc_i in bid_index (unallocated bids) in the right place
-        // according to average price
-        unsigned int index = 0;
-        while (index < bid_index.size() &&
-               tmp_bids.getAvgPrice()[bid_index[index]] >
-                   tmp_bids.getAvgPrice()[alloc_i])
-          ++index;
-        bid_index.insert(bid_index.begin() + index, alloc_i);
-        return;
-      }
-    }
+  // if no seller could be found, look for the first one that has already
+  // allocated its bundle, but would gain more by switching to this bidder:
+  // alternate between the next ask allocated to a bidder of lower value and
+  // the next compatible ask, until they agree
+  double value = instance.getBids().V()[i];
+  q = t.matched_value.firstBelow(0, value);
+  while (q < compatible_asks->size()) {
+    unsigned int c = compatible_asks->next(i, q);
+    if (c == q) break;
+    q = t.matched_value.firstBelow(c, value);
   }
+  if (q >= compatible_asks->size()) return;
+  int j = compatible_asks->at(q);
+  // check which bidder it already allocated goods to
+  int alloc_i = t.bid_of[j];
+
+  // change from alloc_i to i, an increase in revenue
+  t.bid_of[j] = i;
+  t.matched_value.set(q, value);
+  t.welfare += value - instance.getBids().V()[alloc_i];
+  t.last_improved_era = t.era;
+  // update bid birthday
+  t.birthday[i] = t.era;
+  // once this bid was allocated, remove from list of unallocated bids,
+  // and put alloc_i back in its place according to average price
+  t.unallocated_bids.erase(p);
+  t.unallocated_bids.insert(bid_position[alloc_i]);
 }
 
-void CACasanova::resetBetweenTries() {
-  allocated_asks.clear();
-  bid_index = bids_sorted;
-  ask_index = asks_sorted;
-  welfare = 0.;
-
-  // initialise all prices to 0
-  for (unsigned int i = 0; i < instance.getBids().N(); ++i) {
-    price_buyer[i] = 0.;
-  }
-  for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-    price_seller[j] = 0.;
-  }
-
-  stats = Stats();
-
-  // reset birthdays
-  birthday = std::vector<int>(instance.getBids().N(), -1);
+void CACasanova::resetBetweenTries(Try &t) {
+  t.bid_of.assign(instance.getAsks().N(), -1);
+  t.unallocated_bids = RankedSet(bids_sorted.size());
+  t.unallocated_bids.fill();
+  t.free_asks = compatible_asks->all();
+  t.matched_value = MinimumTree(asks_sorted.size());
+  t.num_free_asks = instance.getAsks().N();
+  t.welfare = 0.;
+  t.birthday.assign(instance.getBids().N(), -1);
 }
 
 void CACasanova::resetAllocation() {
   resetBase();
-  allocated_asks.clear();
-  welfare = 0.;
-  // reset birthdays
-  birthday = std::vector<int>(instance.getBids().N(), -1);
   // reset best welfare between computeAllocation calls
   best_welfare = 0.;
-  best_allocated_asks.clear();
+  best_bid_of.clear();
+  bids_sorted.clear();
+  asks_sorted.clear();
+  bid_position.clear();
+  compatible_asks.reset();
 }
 
 bool CACasanova::noSideEffects() {
   // side effects from casanova-related variables
-  if (welfare) return false;
-  if (!allocated_asks.empty()) return false;
-  for (unsigned int i = 0; i < instance.getBids().N(); ++i)
-    if (birthday[i] >= 0) return false;
-
   if (best_welfare) return false;
-  if (!best_allocated_asks.empty()) return false;
+  if (!best_bid_of.empty()) return false;
+  if (!bids_sorted.empty() || !asks_sorted.empty()) return false;
+  if (!bid_position.empty() || compatible_asks) return false;
 
   return noSideEffectsBase();
 }
@@ -188,4 +189,12 @@ bool CACasanova::noSideEffects() {
 // calculates the age of a given bid based on its birthday and current era
 // @param i the index of the bid
 // @return age
-int CACasanova::age(unsigned int i) { return era - birthday[i]; }
+int CACasanova::age(const Try &t, unsigned int i) {
+  return t.era - t.birthday[i];
+}
+
+// @param r the rank of a bid among the unallocated bids
+// @return the index of the bid
+int CACasanova::unallocatedBid(const Try &t, unsigned int r) {
+  return bids_sorted[t.unallocated_bids.select(r)];
+}
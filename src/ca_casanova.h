@@ -19,34 +19,57 @@
 #define CA_CASANOVA_H_
 
 #include <boost/numeric/ublas/matrix.hpp>
-#include <boost/unordered_map.hpp>
 
 #include <random>
 #include <vector>
 
 #include "src/ca.h"
+#include "src/minimum_tree.h"
+#include "src/ordered_compatibility.h"
+#include "src/ranked_set.h"
+#include "src/thread_pool.h"
 
+// Each of the tries is a restart from the empty allocation, with its own
+// state and generator; the tries run concurrently and the best one is kept.
+// The generators of the tries are seeded from one generator, so the result
+// does not depend on the number of threads.
 class CACasanova : public CA {
  public:
-  CACasanova(Instance instance_);
+  CACasanova(InstancePtr instance_);
   ~CACasanova();
 
   bool noSideEffects();
   void resetAllocation();
 
  private:
+  // working state of a try
+  struct Try {
+    std::mt19937_64 generator;
+    std::vector<uint64_t> free_asks;  // as a subset of compatible_asks
+    // value of the bid allocated to each ask, by position in asks_sorted
+    MinimumTree matched_value;
+    unsigned int num_free_asks;
+    RankedSet unallocated_bids;  // positions in bids_sorted
+    std::vector<int> bid_of;     // bid allocated to each ask, -1 if none
+    double welfare;
+    std::vector<int> birthday;
+    unsigned int era;
+    unsigned int last_improved_era;
+  };
+
   void computeAllocation();
-  void resetBetweenTries();
-  inline int age(unsigned int i);
-  void insert(unsigned int i);
+  void resetBetweenTries(Try &t);
+  void search(Try &t);
+  inline int age(const Try &t, unsigned int i);
+  inline int unallocatedBid(const Try &t, unsigned int r);
+  void insert(Try &t, unsigned int r);
 
   std::vector<int> bids_sorted;
   std::vector<int> asks_sorted;
-  boost::unordered_map<int, int> allocated_asks;
-  double welfare = 0.;
+  std::vector<unsigned int> bid_position;  // position in bids_sorted
+  // compatible asks of each bid in the order of asks_sorted
+  std::shared_ptr<const OrderedCompatibility> compatible_asks;
 
-  std::vector<int> birthday;
-  unsigned int era = 0;
   unsigned int maxSteps;
 
   const double wp = 0.15;  // walk probability
@@ -56,16 +79,9 @@ class CACasanova : public CA {
   // soft restart strategy: if at least theta steps have occured since reinit,
   // but no improvement within the last theta/2 steps
   unsigned int theta;
-  unsigned int last_improved_era;
-
-  // variables for random number generation
-  std::mt19937_64 generator;
-  std::uniform_int_distribution<> distribution_neighbor;
-  std::uniform_real_distribution<> distribution_wp;
-  std::uniform_real_distribution<> distribution_np;
 
   // the best solution
-  boost::unordered_map<int, int> best_allocated_asks;
+  std::vector<int> best_bid_of;
   double best_welfare = 0.;
 };
 
@@ -17,13 +17,14 @@
 
 #include "ca_casanova_s.h"
 
-CACasanovaS::CACasanovaS(Instance instance_)
+CACasanovaS::CACasanovaS(InstancePtr instance_)
     : CA(instance_),
-      maxSteps(instance_.getAsks().N()),
-      theta(instance_.getAsks().N()/4),
-      distribution_neighbor(0, instance_.getAsks().N() - 1),
-      distribution_wp(0.0, 1.0),
-      distribution_np(0.0, 1.0) {
+      maxSteps(instance_->getAsks().N()),
+      theta(instance_->getAsks().N()/4) {}
+
+CACasanovaS::~CACasanovaS() {}
+
+void CACasanovaS::computeAllocation() {
   // init sorted bids
   for (unsigned int i = 0; i < instance.getBids().N(); ++i)
     bids_sorted.push_back(i);
@@ -39,146 +40,146 @@ CACasanovaS::CACasanovaS(Instance instance_)
             [&](unsigned int i, unsigned int j) -> bool {
               return tmp_asks.getAvgPrice()[i] < tmp_asks.getAvgPrice()[j];
             });
-}
+  ask_position.resize(asks_sorted.size());
+  for (unsigned int p = 0; p < asks_sorted.size(); ++p)
+    ask_position[asks_sorted[p]] = p;
+  compatible_bids = instance.orderedCompatibility(false, bids_sorted);
+
+  // the generators of the tries are seeded from one seeded with rd(), unless
+  // a seed was set
+  std::mt19937_64 generator(nextSeed());
+  std::vector<Try> tries(maxTries);
+  for (auto &t : tries) t.generator.seed(generator());
+
+  // the calling thread runs a try too
+  ThreadPool pool(std::min(num_threads, maxTries) - 1);
+  pool.parallelFor(0, maxTries, [&](unsigned int k) { search(tries[k]); });
+
+  // the first best try, as if they had run one after the other
+  for (auto &t : tries) {
+    if (t.welfare > best_welfare) {
+      best_welfare = t.welfare;
+      best_ask_of = t.ask_of;
+    }
+  }
 
-CACasanovaS::~CACasanovaS() {}
+  for (unsigned int i = 0; i < best_ask_of.size(); ++i) {
+    if (best_ask_of[i] < 0) continue;
+    x[i] = 1;
+    y.allocate(i, best_ask_of[i]);
+  }
+}
 
-void CACasanovaS::computeAllocation() {
-  // reset random generator
-  std::random_device rd;
-  generator.seed(rd());
-
-  for (unsigned int tries = 0; tries < maxTries; ++tries) {
-    resetBetweenTries();
-
-    for (era = 0, last_improved_era = 0;
-         era < maxSteps && bid_index.size() && ask_index.size() &&
-         (era < theta || era - last_improved_era < theta / 2);
-         ++era) {
-      if (distribution_wp(generator) < wp) {
-        // allocate a random ask
-        unsigned int j = distribution_neighbor(generator) % ask_index.size();
-        insert(j);
+// Runs a try from the empty allocation.
+void CACasanovaS::search(Try &t) {
+  std::uniform_int_distribution<> distribution_neighbor(
+      0, instance.getAsks().N() - 1);
+  std::uniform_real_distribution<> distribution_wp(0.0, 1.0);
+  std::uniform_real_distribution<> distribution_np(0.0, 1.0);
+
+  resetBetweenTries(t);
+  for (t.era = 0, t.last_improved_era = 0;
+       t.era < maxSteps && t.num_free_bids && t.unallocated_asks.size() &&
+       (t.era < theta || t.era - t.last_improved_era < theta / 2);
+       ++t.era) {
+    if (distribution_wp(t.generator) < wp) {
+      // allocate a random ask
+      unsigned int r =
+          distribution_neighbor(t.generator) % t.unallocated_asks.size();
+      insert(t, r);
+    } else {
+      if (t.unallocated_asks.size() == 1 ||
+          age(t, unallocatedAsk(t, 0)) > age(t, unallocatedAsk(t, 1))) {
+        insert(t, 0);
       } else {
-        if (ask_index.size() == 1 || age(ask_index[0]) > age(ask_index[1])) {
-          insert(0);
+        if (distribution_np(t.generator) < np) {
+          insert(t, 1);
         } else {
-          if (distribution_np(generator) < np) {
-            insert(1);
-          } else {
-            insert(0);
-          }
+          insert(t, 0);
         }
       }
     }
-    if (welfare > best_welfare) {
-      best_welfare = welfare;
-      best_allocated_bids = allocated_bids;
-    }
-  }
-  
-  welfare = best_welfare;
-  for (auto it : best_allocated_bids) {
-    x[it.first] = 1;
-    y(it.first, it.second) = 1;
   }
 }
 
 // Allocates the given ask (if possible).
-// @param j the ask index in the list of unallocated asks 'asks'
-void CACasanovaS::insert(unsigned int j) {
+// @param r the rank of the ask among the unallocated asks, in the order of
+// asks_sorted
+void CACasanovaS::insert(Try &t, unsigned int r) {
+  unsigned int p = t.unallocated_asks.select(r);
+  int j = asks_sorted[p];
   // look for a bidder in the list of unallocated bids
-  unsigned int i = 0;
-  while (i < bid_index.size()) {
-    // seller j can allocate resources to bidder i
-    if (instance.canAllocate(bid_index[i], ask_index[j])) {
-      welfare += instance.getBids().V()[bid_index[i]] -
-                 instance.getAsks().V()[ask_index[j]];
-      last_improved_era = era;
-      allocated_bids[bid_index[i]] = ask_index[j];
-      bid_index.erase(bid_index.begin() + i);
-      // update ask birthday
-      birthday[ask_index[j]] = era;
-      // once this ask was allocated, remove from list of unallocated asks
-      ask_index.erase(ask_index.begin() + j);
-      return;
-    }
-    ++i;
+  unsigned int q = compatible_bids->first(j, t.free_bids);
+  if (q < compatible_bids->size()) {
+    int i = compatible_bids->at(q);
+    t.welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+    t.last_improved_era = t.era;
+    t.ask_of[i] = j;
+    compatible_bids->toggle(t.free_bids, i);
+    t.matched_value.set(q, -instance.getAsks().V()[j]);
+    --t.num_free_bids;
+    // update ask birthday
+    t.birthday[j] = t.era;
+    // once this ask was allocated, remove from list of unallocated asks
+    t.unallocated_asks.erase(p);
+    return;
   }
-  // return;
-  // if no bidder could be found, look for one that has already been allocated
-  // a bundle, but would gain more by switching to this seller
-  for (auto it : allocated_bids) {
-    i = it.first;
-    if (instance.canAllocate(i, ask_index[j])) {
-      // check which seller already allocated its goods to this bidder
-      unsigned int alloc_j = it.second;
-
-      // change from alloc_j to ask_index[j] only if there is an increase in revenue
-      if (instance.getAsks().V()[alloc_j] >
-          instance.getAsks().V()[ask_index[j]]) {
-        allocated_bids[i] = ask_index[j];
-        welfare += instance.getAsks().V()[alloc_j] -
-                   instance.getAsks().V()[ask_index[j]];
-        last_improved_era = era;
-        // update ask birthday
-        birthday[ask_index[j]] = era;
-        // once this ask was allocated, remove from list of unallocated asks
-        ask_index.erase(ask_index.begin() + j);
-        // insert alloc_j in ask_index (unallocated asks) in the right place
-        // according to average price
-        unsigned int index = 0;
-        while (index < ask_index.size() &&
-               tmp_asks.getAvgPrice()[ask_index[index]] <
-                   tmp_asks.getAvgPrice()[alloc_j])
-          ++index;
-        ask_index.insert(ask_index.begin() + index, alloc_j);
-        return;
-      }
-    }
-    ++i;
+  // if no bidder could be found, look for the first one that has already
+  // been allocated a bundle, but would gain more by switching to this seller,
+  // as in CACasanova::insert
+  double value = instance.getAsks().V()[j];
+  q = t.matched_value.firstBelow(0, -value);
+  while (q < compatible_bids->size()) {
+    unsigned int c = compatible_bids->next(j, q);
+    if (c == q) break;
+    q = t.matched_value.firstBelow(c, -value);
   }
+  if (q >= compatible_bids->size()) return;
+  int i = compatible_bids->at(q);
+  // check which seller already allocated its goods to this bidder
+  int alloc_j = t.ask_of[i];
+
+  // change from alloc_j to j, an increase in revenue
+  t.ask_of[i] = j;
+  t.matched_value.set(q, -value);
+  t.welfare += instance.getAsks().V()[alloc_j] - value;
+  t.last_improved_era = t.era;
+  // update ask birthday
+  t.birthday[j] = t.era;
+  // once this ask was allocated, remove from list of unallocated asks,
+  // and put alloc_j back in its place according to average price
+  t.unallocated_asks.erase(p);
+  t.unallocated_asks.insert(ask_position[alloc_j]);
 }
 
-void CACasanovaS::resetBetweenTries() {
-  allocated_bids.clear();
-  bid_index = bids_sorted;
-  ask_index = asks_sorted;
-  welfare = 0.;
-
-  // initialise all prices to 0
-  for (unsigned int i = 0; i < instance.getBids().N(); ++i) {
-    price_buyer[i] = 0.;
-  }
-  for (unsigned int j = 0; j < instance.getAsks().N(); ++j) {
-    price_seller[j] = 0.;
-  }
-
-  stats = Stats();
-  // reset birthdays
-  birthday = std::vector<int>(instance.getAsks().N(), -1);
+void CACasanovaS::resetBetweenTries(Try &t) {
+  t.ask_of.assign(instance.getBids().N(), -1);
+  t.unallocated_asks = RankedSet(asks_sorted.size());
+  t.unallocated_asks.fill();
+  t.free_bids = compatible_bids->all();
+  t.matched_value = MinimumTree(bids_sorted.size());
+  t.num_free_bids = instance.getBids().N();
+  t.welfare = 0.;
+  t.birthday.assign(instance.getAsks().N(), -1);
 }
 
 void CACasanovaS::resetAllocation() {
   resetBase();
-  allocated_bids.clear();
-  welfare = 0.;
-  // reset birthdays
-  birthday = std::vector<int>(instance.getAsks().N(), -1);
   // reset best welfare between computeAllocation calls
   best_welfare = 0.;
-  best_allocated_bids.clear();
+  best_ask_of.clear();
+  bids_sorted.clear();
+  asks_sorted.clear();
+  ask_position.clear();
+  compatible_bids.reset();
 }
 
 bool CACasanovaS::noSideEffects() {
   // side effects from casanova-related variables
-  if (welfare) return false;
-  if (!allocated_bids.empty()) return false;
-  for (unsigned int i = 0; i < instance.getBids().N(); ++i)
-    if (birthday[i] >= 0) return false;
-
   if (best_welfare) return false;
-  if (!best_allocated_bids.empty()) return false;
+  if (!best_ask_of.empty()) return false;
+  if (!bids_sorted.empty() || !asks_sorted.empty()) return false;
+  if (!ask_position.empty() || compatible_bids) return false;
 
   return noSideEffectsBase();
 }
@@ -186,4 +187,12 @@ bool CACasanovaS::noSideEffects() {
 // calculates the age of a given ask based on its birthday and current era
 // @param j the index of the ask
 // @return age
-int CACasanovaS::age(unsigned int j) { return era - birthday[j]; }
+int CACasanovaS::age(const Try &t, unsigned int j) {
+  return t.era - t.birthday[j];
+}
+
+// @param r the rank of an ask among the unallocated asks
+// @return the index of the ask
+int CACasanovaS::unallocatedAsk(const Try &t, unsigned int r) {
+  return asks_sorted[t.unallocated_asks.select(r)];
+}
@@ -19,34 +19,56 @@
 #define CA_CASANOVA_S_H_
 
 #include <boost/numeric/ublas/matrix.hpp>
-#include <boost/unordered_map.hpp>
 
 #include <random>
 #include <vector>
 
 #include "src/ca.h"
+#include "src/minimum_tree.h"
+#include "src/ordered_compatibility.h"
+#include "src/ranked_set.h"
+#include "src/thread_pool.h"
 
+// Casanova with the roles of bids and asks exchanged; the tries run
+// concurrently as in CACasanova.
 class CACasanovaS : public CA {
  public:
-  CACasanovaS(Instance instance_);
+  CACasanovaS(InstancePtr instance_);
   ~CACasanovaS();
 
   bool noSideEffects();
   void resetAllocation();
 
  private:
+  // working state of a try
+  struct Try {
+    std::mt19937_64 generator;
+    std::vector<uint64_t> free_bids;  // as a subset of compatible_bids
+    // value of the ask allocated to each bid, negated to find the ones above
+    // a bound, by position in bids_sorted
+    MinimumTree matched_value;
+    unsigned int num_free_bids;
+    RankedSet unallocated_asks;  // positions in asks_sorted
+    std::vector<int> ask_of;     // ask allocated to each bid, -1 if none
+    double welfare;
+    std::vector<int> birthday;
+    unsigned int era;
+    unsigned int last_improved_era;
+  };
+
   void computeAllocation();
-  void resetBetweenTries();
-  inline int age(unsigned int j);
-  void insert(unsigned int j);
+  void resetBetweenTries(Try &t);
+  void search(Try &t);
+  inline int age(const Try &t, unsigned int j);
+  inline int unallocatedAsk(const Try &t, unsigned int r);
+  void insert(Try &t, unsigned int r);
 
   std::vector<int> bids_sorted;
   std::vector<int> asks_sorted;
-  boost::unordered_map<int, int> allocated_bids;
-  double welfare = 0.;
+  std::vector<unsigned int> ask_position;  // position in asks_sorted
+  // compatible bids of each ask in the order of bids_sorted
+  std::shared_ptr<const OrderedCompatibility> compatible_bids;
 
-  std::vector<int> birthday;
-  unsigned int era = 0;
   unsigned int maxSteps;
 
   const double wp = 0.15;  // walk probability
@@ -56,16 +78,9 @@ class CACasanovaS : public CA {
   // soft restart strategy: if at least theta steps have occured since reinit,
   // but no improvement within the last theta/2 steps
   unsigned int theta;
-  unsigned int last_improved_era;
-
-  // variables for random number generation
-  std::mt19937_64 generator;
-  std::uniform_int_distribution<> distribution_neighbor;
-  std::uniform_real_distribution<> distribution_wp;
-  std::uniform_real_distribution<> distribution_np;
 
   // the best solution
-  boost::unordered_map<int, int> best_allocated_bids;
+  std::vector<int> best_ask_of;
   double best_welfare = 0.;
 };
 
@@ -17,7 +17,7 @@
 
 #include "ca_cplex.h"
 
-CACplex::CACplex(Instance instance_) : CA(instance_) {}
+CACplex::CACplex(InstancePtr instance_) : CA(instance_) {}
 
 CACplex::~CACplex() {}
 
@@ -49,7 +49,7 @@ void CACplex::computeAllocation() {
     }
     for (unsigned int i = 0; i < n; ++i) {
       for (unsigned int j = 0; j < m; ++j) {
-        y(i, j) = vals[n + i * m + j];
+        if (vals[n + i * m + j] > 0.5) y.allocate(i, j);
       }
     }
   } catch (IloException& e) {
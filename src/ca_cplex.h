@@ -30,7 +30,7 @@ ILOSTLBEGIN
 
 class CACplex: public CA {
  public:
-    CACplex(Instance instance_);
+    CACplex(InstancePtr instance_);
     ~CACplex();
     void computeAllocation();
  private:
@@ -17,7 +17,7 @@
 
 #include "ca_cplex_rlps.h"
 
-CACplexRLPS::CACplexRLPS(Instance instance_) : CA(instance_) {}
+CACplexRLPS::CACplexRLPS(InstancePtr instance_) : CA(instance_) {}
 
 CACplexRLPS::~CACplexRLPS() {}
 
@@ -71,7 +71,7 @@ void CACplexRLPS::computeAllocation() {
       // seller ask_index[j] can allocate resources to bidder bid_index[i]
       if (instance.canAllocate(bid_index[i], ask_index[j])) {
         x[bid_index[i]] = 1;
-        y(bid_index[i], ask_index[j]) = 1;
+        y.allocate(bid_index[i], ask_index[j]);
         ++i;
       }
       ++j;
@@ -30,7 +30,7 @@ class CACplexRLPS : public CA {
   std::vector<double> xj;
 
  public:
-  CACplexRLPS(Instance instance_);
+  CACplexRLPS(InstancePtr instance_);
   ~CACplexRLPS();
 
   bool noSideEffects();
@@ -19,6 +19,7 @@
 #define SRC_CA_FACTORY_H_
 
 #include "src/ca.h"
+#include "src/ca_bertsekas.h"
 #include "src/ca_casanova.h"
 #include "src/ca_casanova_s.h"
 #include "src/ca_greedy1.h"
@@ -29,7 +30,9 @@
 #include "src/ca_hill1_s.h"
 #include "src/ca_hill2.h"
 #include "src/ca_hill2_s.h"
+#include "src/ca_matching.h"
 #include "src/ca_sa.h"
+#include "src/ca_sa_pt.h"
 #include "src/ca_sa_s.h"
 #include "src/helper.h"
 
@@ -40,7 +43,18 @@
 
 class CAFactory {
  public:
-  static CA* createAuction(Instance instance, AuctionType type) {
+  // @param num_threads threads a run may use, including the calling one
+  static CA* createAuction(
+      InstancePtr instance, AuctionType type,
+      double epsilon = CABertsekas::default_epsilon,
+      unsigned int num_threads = 1) {
+    CA* ca = create(instance, type, epsilon);
+    if (ca) ca->setThreads(num_threads);
+    return ca;
+  }
+
+ private:
+  static CA* create(InstancePtr instance, AuctionType type, double epsilon) {
     switch (type) {
       case AuctionType::GREEDY1:
         return new CAGreedy1(instance);
@@ -66,6 +80,12 @@ class CAFactory {
         return new CACasanova(instance);
       case AuctionType::CASANOVAS:
         return new CACasanovaS(instance);
+      case AuctionType::MATCHING:
+        return new CAMatching(instance);
+      case AuctionType::BERTSEKAS:
+        return new CABertsekas(instance, epsilon);
+      case AuctionType::SAPT:
+        return new CASAPT(instance);
 #ifdef _CPLEX
       case AuctionType::CPLEX:
         return new CACplex(instance);
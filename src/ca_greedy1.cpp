@@ -17,7 +17,7 @@
 
 #include "ca_greedy1.h"
 
-CAGreedy1::CAGreedy1(Instance instance_)
+CAGreedy1::CAGreedy1(InstancePtr instance_)
     : CA(instance_, RelevanceMode::UNIFORM) {}
 
 CAGreedy1::~CAGreedy1() {}
@@ -44,7 +44,7 @@ void CAGreedy1::computeAllocation() {
     // seller ask_index[j] can allocate resources to bidder bid_index[i]
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       ++i;
     }
     ++j;
@@ -22,7 +22,7 @@
 
 class CAGreedy1 : public CA {
  public:
-  CAGreedy1(Instance instance_);
+  CAGreedy1(InstancePtr instance_);
   ~CAGreedy1();
 
  private:
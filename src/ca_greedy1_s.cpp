@@ -17,7 +17,7 @@
 
 #include "ca_greedy1_s.h"
 
-CAGreedy1S::CAGreedy1S(Instance instance_)
+CAGreedy1S::CAGreedy1S(InstancePtr instance_)
     : CA(instance_, RelevanceMode::UNIFORM) {}
 
 CAGreedy1S::~CAGreedy1S() {}
@@ -44,7 +44,7 @@ void CAGreedy1S::computeAllocation() {
     // seller ask_index[j] can allocate resources to bidder bid_index[i]
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       ++j;
     }
     ++i;
@@ -22,7 +22,7 @@
 
 class CAGreedy1S : public CA {
  public:
-  CAGreedy1S(Instance instance_);
+  CAGreedy1S(InstancePtr instance_);
   ~CAGreedy1S();
 
  private:
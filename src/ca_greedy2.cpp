@@ -17,7 +17,7 @@
 
 #include "ca_greedy2.h"
 
-CAGreedy2::CAGreedy2(Instance instance_)
+CAGreedy2::CAGreedy2(InstancePtr instance_)
     : CA(instance_, RelevanceMode::SCARCITY) {}
 
 CAGreedy2::~CAGreedy2() {}
@@ -44,7 +44,7 @@ void CAGreedy2::computeAllocation() {
     // seller ask_index[j] can allocate resources to bidder bid_index[i]
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       ++i;
     }
     ++j;
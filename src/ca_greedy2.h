@@ -22,7 +22,7 @@
 
 class CAGreedy2 : public CA {
  public:
-  CAGreedy2(Instance instance_);
+  CAGreedy2(InstancePtr instance_);
   ~CAGreedy2();
 
  private:
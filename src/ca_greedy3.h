@@ -22,7 +22,7 @@
 
 class CAGreedy3 : public CA {
  public:
-  CAGreedy3(Instance instance_);
+  CAGreedy3(InstancePtr instance_);
   ~CAGreedy3();
 
  private:
@@ -17,7 +17,7 @@
 
 #include "ca_hill1.h"
 
-CAHill1::CAHill1(Instance instance_) : CA(instance_) {}
+CAHill1::CAHill1(InstancePtr instance_) : CA(instance_) {}
 
 CAHill1::~CAHill1() {}
 
@@ -34,61 +34,34 @@ void CAHill1::computeAllocation() {
             });
 
   // compute initial solution
-  welfare = computeGreedyWelfare();
-  best_bid_index = bid_index;
+  evaluator = GreedyEvaluator(instance, true, ask_index);
+  welfare = evaluator.checkpoint(bid_index, critical_i);
 
-  // gradient descent
-  while (locallyImprove())
+  // gradient descent; the calling thread takes part in the evaluations
+  ThreadPool pool(num_threads - 1);
+  while (locallyImprove(pool))
     ;
 
   // compute solution (x and y) based on best ordering; welfare already computed
-  bid_index = best_bid_index;
   unsigned int i = 0;
   unsigned int j = 0;
   while (i < instance.getBids().N() && j < instance.getAsks().N()) {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       ++i;
     }
     ++j;
   }
 }
 
-bool CAHill1::locallyImprove() {
-  unsigned int i = critical_i + 1;
-  while (i < instance.getBids().N()) {
-    // get the neighbor by changing the order of one request
-    // moving bid i to front
-    std::rotate(bid_index.begin(), bid_index.begin() + i,
-                bid_index.begin() + i + 1);
-    // get welfare of neighbor
-    double new_welfare = computeGreedyWelfare();
-    // check improvement
-    if (new_welfare > welfare) {
-      best_bid_index = bid_index;
-      welfare = new_welfare;
-      return true;
-    }
-    ++i;
-  }
-  return false;
-}
-
-double CAHill1::computeGreedyWelfare() {
-  double new_welfare = 0.;
-  unsigned int i = 0;
-  unsigned int j = 0;
-  critical_i = 0;
-  while (i < instance.getBids().N() && j < instance.getAsks().N()) {
-    // seller ask_index[j] can allocate resources to bidder bid_index[i]
-    if (instance.canAllocate(bid_index[i], ask_index[j])) {
-      new_welfare += instance.getBids().V()[bid_index[i]] -
-                     instance.getAsks().V()[ask_index[j]];
-      critical_i = i;
-      ++i;
-    }
-    ++j;
-  }
-  return new_welfare;
+bool CAHill1::locallyImprove(ThreadPool &pool) {
+  unsigned int first = critical_i + 1;
+  // first improving neighbor, changing the order of one request:
+  // moving bid i to front, after the bids first..i-1 were moved there
+  unsigned int i = evaluator.firstImprovement(first, welfare, pool);
+  if (i >= instance.getBids().N()) return false;
+  GreedyEvaluator::rotate(bid_index, first, i);
+  welfare = evaluator.checkpoint(bid_index, critical_i);
+  return true;
 }
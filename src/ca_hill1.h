@@ -24,21 +24,21 @@
 #include <vector>
 
 #include "src/ca.h"
+#include "src/greedy_evaluator.h"
+#include "src/thread_pool.h"
 
 class CAHill1 : public CA {
  public:
-  CAHill1(Instance instance_);
+  CAHill1(InstancePtr instance_);
   ~CAHill1();
 
  private:
   void computeAllocation();
-  double computeGreedyWelfare();
-  bool locallyImprove();
+  bool locallyImprove(ThreadPool &pool);
 
   double welfare = 0.;
-
-  // temporary vars
-  std::vector<int> best_bid_index;
+  // welfare of the current ordering and of its neighbors
+  GreedyEvaluator evaluator;
 
   // critical index, or last allocated bid
   unsigned int critical_i;
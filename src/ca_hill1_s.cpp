@@ -17,7 +17,7 @@
 
 #include "ca_hill1_s.h"
 
-CAHill1S::CAHill1S(Instance instance_) : CA(instance_) {}
+CAHill1S::CAHill1S(InstancePtr instance_) : CA(instance_) {}
 
 CAHill1S::~CAHill1S() {}
 
@@ -34,61 +34,34 @@ void CAHill1S::computeAllocation() {
             });
 
   // compute initial solution
-  welfare = computeGreedyWelfare();
-  best_ask_index = ask_index;
+  evaluator = GreedyEvaluator(instance, false, bid_index);
+  welfare = evaluator.checkpoint(ask_index, critical_j);
 
-  // gradient descent
-  while (locallyImprove())
+  // gradient descent; the calling thread takes part in the evaluations
+  ThreadPool pool(num_threads - 1);
+  while (locallyImprove(pool))
     ;
 
   // compute solution (x and y) based on best ordering; welfare already computed
-  ask_index = best_ask_index;
   unsigned int i = 0;
   unsigned int j = 0;
   while (i < instance.getBids().N() && j < instance.getAsks().N()) {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       ++j;
     }
     ++i;
   }
 }
 
-bool CAHill1S::locallyImprove() {
-  unsigned int j = critical_j + 1;
-  while (j < instance.getAsks().N()) {
-    // get the neighbor by changing the order of one request
-    // moving ask j to front
-    std::rotate(ask_index.begin(), ask_index.begin() + j,
-                ask_index.begin() + j + 1);
-    // get welfare of neighbor
-    double new_welfare = computeGreedyWelfare();
-    // check improvement
-    if (new_welfare > welfare) {
-      best_ask_index = ask_index;
-      welfare = new_welfare;
-      return true;
-    }
-    ++j;
-  }
-  return false;
-}
-
-double CAHill1S::computeGreedyWelfare() {
-  double new_welfare = 0.;
-  unsigned int i = 0;
-  unsigned int j = 0;
-  critical_j = 0;
-  while (i < instance.getBids().N() && j < instance.getAsks().N()) {
-    // seller ask_index[j] can allocate resources to bidder bid_index[i]
-    if (instance.canAllocate(bid_index[i], ask_index[j])) {
-      new_welfare += instance.getBids().V()[bid_index[i]] -
-                     instance.getAsks().V()[ask_index[j]];
-      critical_j = j;
-      ++j;
-    }
-    ++i;
-  }
-  return new_welfare;
+bool CAHill1S::locallyImprove(ThreadPool &pool) {
+  unsigned int first = critical_j + 1;
+  // first improving neighbor, changing the order of one request:
+  // moving ask j to front, after the asks first..j-1 were moved there
+  unsigned int j = evaluator.firstImprovement(first, welfare, pool);
+  if (j >= instance.getAsks().N()) return false;
+  GreedyEvaluator::rotate(ask_index, first, j);
+  welfare = evaluator.checkpoint(ask_index, critical_j);
+  return true;
 }
@@ -24,21 +24,21 @@
 #include <vector>
 
 #include "src/ca.h"
+#include "src/greedy_evaluator.h"
+#include "src/thread_pool.h"
 
 class CAHill1S : public CA {
  public:
-  CAHill1S(Instance instance_);
+  CAHill1S(InstancePtr instance_);
   ~CAHill1S();
 
  private:
   void computeAllocation();
-  double computeGreedyWelfare();
-  bool locallyImprove();
+  bool locallyImprove(ThreadPool &pool);
 
   double welfare = 0.;
-
-  // temporary vars
-  std::vector<int> best_ask_index;
+  // welfare of the current ordering and of its neighbors
+  GreedyEvaluator evaluator;
 
   // critical index, or last allocated ask
   unsigned int critical_j;
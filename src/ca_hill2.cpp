@@ -17,67 +17,40 @@
 
 #include "ca_hill2.h"
 
-CAHill2::CAHill2(Instance instance_)
+CAHill2::CAHill2(InstancePtr instance_)
     : CA(instance_),
-      z(instance_.getAsks().N(), 0),
-      distribution_neighbor(0, instance_.getBids().N() - 1) {}
+      z(instance_->getAsks().N(), 0) {}
 
 CAHill2::~CAHill2() {}
 
 void CAHill2::computeAllocation() {
-  // seed mersenne_twister_engine with rd()
-  std::random_device rd;
-  generator.seed(rd());
+  // seed mersenne_twister_engine with rd(), unless a seed was set
+  generator.seed(nextSeed());
 
   generateInitialSolution();
   while (locallyImprove())
     ;
 }
 
+// Toggles x_i of a random bid among the ones with an improving move, i.e.
+// with x_i==0 and the first free compatible ask in sorted order giving a
+// positive welfare; stops at a local optimum, when there is none.
 bool CAHill2::locallyImprove() {
-  unsigned int n = instance.getBids().N();
-  unsigned int m = instance.getAsks().N();
-
-  Neighbor neigh;
-  neigh.welfare = welfare;
-  neigh.found = false;
+  if (!candidates.size()) return false;
 
   // randomly select one bid
-  unsigned int i = distribution_neighbor(generator);
-  if (x[i] == 0) {
-    // x_i==0, try to find an ask to match from sorted asks
-    unsigned int j = 0;
-    while (j < m) {
-      // check if seller j has already allocated its resources
-      if (z[ask_index[j]] == 0) {
-        // seller ask_index[j] can allocate resources to bidder i
-        if (instance.canAllocate(i, ask_index[j])) {
-          neigh.welfare +=
-              instance.getBids().V()[i] - instance.getAsks().V()[ask_index[j]];
-          neigh.bid = i;
-          neigh.ask = ask_index[j];
-          neigh.found = true;
-          break;
-        }
-      }
-      ++j;
-    }
-  }
+  std::uniform_int_distribution<> distribution_neighbor(
+      0, candidates.size() - 1);
+  int i = candidates.leader(distribution_neighbor(generator));
+  int j = candidates.partner(i);
 
-  if (neigh.found && neigh.welfare > welfare) {
-    // update allocation
-    x[neigh.bid] = 1;
-    z[neigh.ask] = 1;
-    y(neigh.bid, neigh.ask) = 1;
-    welfare = neigh.welfare;
-    num_neighbors = 0;
-    return true;
-  }
-  if (num_neighbors < n) {
-    ++num_neighbors;
-    return true;
-  }
-  return false;
+  // update allocation
+  x[i] = 1;
+  z[j] = 1;
+  candidates.allocate(i);
+  y.allocate(i, j);
+  welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+  return true;
 }
 
 void CAHill2::generateInitialSolution() {
@@ -94,6 +67,8 @@ void CAHill2::generateInitialSolution() {
             [&](unsigned int i, unsigned int j) -> bool {
               return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
             });
+  // improving moves, with the unallocated asks in the same order
+  candidates = CandidatePairs(instance, true, ask_index);
   return;
   // compute greedy1 solution
   unsigned int i = 0;
@@ -104,7 +79,7 @@ void CAHill2::generateInitialSolution() {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
       z[ask_index[j]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       welfare += instance.getBids().V()[bid_index[i]] -
                  instance.getAsks().V()[ask_index[j]];
       ++i;
@@ -116,13 +91,13 @@ void CAHill2::generateInitialSolution() {
 void CAHill2::resetAllocation() {
   resetBase();
   welfare = 0.;
-  num_neighbors = 0;
   z = std::vector<int>(instance.getAsks().N(), 0);
+  candidates = CandidatePairs();
 }
 
 bool CAHill2::noSideEffects() {
   if (welfare) return false;
-  if (num_neighbors) return false;
+  if (candidates.size()) return false;
   for (unsigned int j = 0; j < instance.getAsks().N(); ++j)
     if (z[j]) return false;
   return noSideEffectsBase();
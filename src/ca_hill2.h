@@ -25,10 +25,11 @@
 #include <vector>
 
 #include "src/ca.h"
+#include "src/candidate_pairs.h"
 
 class CAHill2 : public CA {
  public:
-  CAHill2(Instance instance_);
+  CAHill2(InstancePtr instance_);
   ~CAHill2();
 
   bool noSideEffects();
@@ -40,14 +41,12 @@ class CAHill2 : public CA {
   bool locallyImprove();
 
   std::vector<int> z;  // same as x, but for sellers
+  // unallocated bids with an improving move
+  CandidatePairs candidates;
   double welfare = 0.;
 
-  // maximum number of neighbors
-  unsigned int num_neighbors = 0;
-
   // variables for random number generation
   std::mt19937_64 generator;
-  std::uniform_int_distribution<> distribution_neighbor;
 };
 
 #endif  // CA_HILL2_H_
@@ -17,17 +17,15 @@
 
 #include "ca_hill2_s.h"
 
-CAHill2S::CAHill2S(Instance instance_)
+CAHill2S::CAHill2S(InstancePtr instance_)
     : CA(instance_),
-      z(instance_.getAsks().N(), 0),
-      distribution_neighbor(0, instance_.getAsks().N() - 1) {}
+      z(instance_->getAsks().N(), 0) {}
 
 CAHill2S::~CAHill2S() {}
 
 void CAHill2S::computeAllocation() {
-  // seed mersenne_twister_engine with rd()
-  std::random_device rd;
-  generator.seed(rd());
+  // seed mersenne_twister_engine with rd(), unless a seed was set
+  generator.seed(nextSeed());
 
   generateInitialSolution();
   while (locallyImprove())
@@ -35,50 +33,24 @@ void CAHill2S::computeAllocation() {
 }
 
 // the neighbors are selected by flipping z bits, i.e. which sellers
-// allocate resources
+// allocate resources, among the asks with an improving move: z_j==0 and the
+// first free compatible bid in sorted order giving a positive welfare
 bool CAHill2S::locallyImprove() {
-  unsigned int n = instance.getBids().N();
-  unsigned int m = instance.getAsks().N();
-
-  Neighbor neigh;
-  neigh.welfare = welfare;
-  neigh.found = false;
+  if (!candidates.size()) return false;
 
   // randomly select one ask
-  unsigned int j = distribution_neighbor(generator);
-  if (z[j] == 0) {
-    // if z_j==0, try to find a bid to match from sorted bids
-    unsigned int i = 0;
-    while (i < n) {
-      // check if bidder i has already allocated its resources
-      if (x[bid_index[i]] == 0) {
-        // seller j can allocate resources to bidder bid_index[i]
-        if (instance.canAllocate(bid_index[i], j)) {
-          neigh.welfare +=
-              instance.getBids().V()[bid_index[i]] - instance.getAsks().V()[j];
-          neigh.bid = bid_index[i];
-          neigh.ask = j;
-          neigh.found = true;
-          break;
-        }
-      }
-      ++i;
-    }
-  }
-  if (neigh.found && neigh.welfare > welfare) {
-    // update allocation
-    x[neigh.bid] = 1;
-    z[neigh.ask] = 1;
-    y(neigh.bid, neigh.ask) = 1;
-    welfare = neigh.welfare;
-    num_neighbors = 0;
-    return true;
-  }
-  if (num_neighbors < m) {
-    ++num_neighbors;
-    return true;
-  }
-  return false;
+  std::uniform_int_distribution<> distribution_neighbor(
+      0, candidates.size() - 1);
+  int j = candidates.leader(distribution_neighbor(generator));
+  int i = candidates.partner(j);
+
+  // update allocation
+  x[i] = 1;
+  z[j] = 1;
+  candidates.allocate(j);
+  y.allocate(i, j);
+  welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+  return true;
 }
 
 void CAHill2S::generateInitialSolution() {
@@ -95,6 +67,8 @@ void CAHill2S::generateInitialSolution() {
             [&](unsigned int i, unsigned int j) -> bool {
               return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
             });
+  // improving moves, with the unallocated bids in the same order
+  candidates = CandidatePairs(instance, false, bid_index);
   return;
   // compute greedy1s solution
   unsigned int i = 0;
@@ -105,7 +79,7 @@ void CAHill2S::generateInitialSolution() {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
       z[ask_index[j]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      y.allocate(bid_index[i], ask_index[j]);
       welfare += instance.getBids().V()[bid_index[i]] -
                  instance.getAsks().V()[ask_index[j]];
       ++j;
@@ -117,13 +91,13 @@ void CAHill2S::generateInitialSolution() {
 void CAHill2S::resetAllocation() {
   resetBase();
   welfare = 0.;
-  num_neighbors = 0;
   z = std::vector<int>(instance.getAsks().N(), 0);
+  candidates = CandidatePairs();
 }
 
 bool CAHill2S::noSideEffects() {
   if (welfare) return false;
-  if (num_neighbors) return false;
+  if (candidates.size()) return false;
   for (unsigned int j = 0; j < instance.getAsks().N(); ++j)
     if (z[j]) return false;
   return noSideEffectsBase();
@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "ca_matching.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+CAMatching::CAMatching(InstancePtr instance_) : CA(instance_) {}
+
+CAMatching::~CAMatching() {}
+
+void CAMatching::computeAllocation() {
+  unsigned int n = instance.getBids().N();
+  unsigned int m = instance.getAsks().N();
+
+  match_bid = std::vector<int>(n, -1);
+  match_ask = std::vector<int>(m, -1);
+  offset = std::vector<double>(m);
+  for (unsigned int j = 0; j < m; ++j) offset[j] = instance.getAsks().V()[j];
+  dist = std::vector<double>(m, std::numeric_limits<double>::infinity());
+  pred = std::vector<int>(m, -1);
+
+  // the offsets of the asks only grow from their values, so the compatible
+  // asks of a bid sorted ascendingly by value are relaxed until the value
+  // alone makes a path longer than the shortest one so far
+  compatible_asks = instance.computeCompatibleAsks();
+  for (auto &asks : compatible_asks)
+    std::sort(asks.begin(), asks.end(), [&](int j, int k) -> bool {
+      return instance.getAsks().V()[j] < instance.getAsks().V()[k];
+    });
+
+  // the insertion order does not affect optimality, but inserting the bids
+  // descendingly by density needs fewer re-routings along augmenting paths
+  std::sort(bid_index.begin(), bid_index.end(),
+            [&](unsigned int i, unsigned int j) -> bool {
+              return tmp_bids.getDensity()[i] > tmp_bids.getDensity()[j];
+            });
+  // the matching stays optimal for the bids inserted so far
+  for (unsigned int i = 0; i < n; ++i) augment(bid_index[i]);
+
+  for (unsigned int i = 0; i < n; ++i) {
+    if (match_bid[i] >= 0) {
+      x[i] = 1;
+      y.allocate(i, match_bid[i]);
+    }
+  }
+}
+
+// Inserts bid r into the matching along a shortest augmenting path.
+// The path ends either in an unmatched ask, or in a bid that becomes
+// unallocated (including r itself), whichever has the lowest cost.
+// @param r the index of the bid to insert
+void CAMatching::augment(unsigned int r) {
+  // asks with a finite distance, to be reset before the next insertion
+  std::vector<unsigned int> reached;
+  std::vector<unsigned int> scanned;
+
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+  // end of the shortest path so far: bid r stays unallocated at cost 0
+  double sink_dist = 0.;
+  int sink_ask = -1;
+  int sink_bid = r;
+
+  // path to ask k through bid i; paths at least as long as the shortest one
+  // so far are not followed, and a path to an unmatched ask ends there
+  auto relax = [&](unsigned int k, double d, unsigned int i) {
+    if (d >= dist[k] || d >= sink_dist) return;
+    if (pred[k] < 0) reached.push_back(k);
+    dist[k] = d;
+    pred[k] = i;
+    if (match_ask[k] >= 0) {
+      queue.push(Entry(d, k));
+    } else {
+      sink_dist = d;
+      sink_ask = k;
+      sink_bid = -1;
+    }
+  };
+
+  // initial distances: edges leaving bid r
+  double v_r = instance.getBids().V()[r];
+  for (int j : compatible_asks[r]) {
+    if (instance.getAsks().V()[j] - v_r >= sink_dist) break;
+    relax(j, offset[j] - v_r, r);
+  }
+
+  while (!queue.empty()) {
+    auto top = queue.top();
+    queue.pop();
+    unsigned int j = top.second;
+    if (top.first > dist[j]) continue;
+    if (top.first >= sink_dist) break;
+    scanned.push_back(j);
+
+    // continue from the bid currently matched to ask j, the edge (i, j) is
+    // tight, so v_i cancels from the reduced costs of the other edges of i
+    int i = match_ask[j];
+    double u_i = offset[j] - instance.getBids().V()[i];
+    // bid i could also give up ask j and stay unallocated
+    if (top.first - u_i < sink_dist) {
+      sink_dist = top.first - u_i;
+      sink_ask = -1;
+      sink_bid = i;
+    }
+    // reduced costs are >= 0, but rounding could bring an ask below its
+    // final distance again, and its predecessors into a cycle
+    double base = top.first - offset[j];
+    for (int k : compatible_asks[i]) {
+      if (base + instance.getAsks().V()[k] >= sink_dist) break;
+      relax(k, std::max(top.first, base + offset[k]), i);
+    }
+  }
+
+  // update dual variables of the asks closer than the end of the path
+  for (unsigned int j : scanned)
+    if (dist[j] < sink_dist) offset[j] -= dist[j] - sink_dist;
+
+  // flip the matching along the path, going back towards bid r
+  int j = sink_ask;
+  if (sink_bid >= 0) {
+    j = match_bid[sink_bid];
+    match_bid[sink_bid] = -1;
+  }
+  while (j >= 0) {
+    int i = pred[j];
+    int next_j = match_bid[i];
+    match_bid[i] = j;
+    match_ask[j] = i;
+    if (i == (int)r) break;
+    j = next_j;
+  }
+
+  for (unsigned int k : reached) {
+    dist[k] = std::numeric_limits<double>::infinity();
+    pred[k] = -1;
+  }
+}
+
+void CAMatching::resetAllocation() {
+  resetBase();
+  compatible_asks = std::vector<std::vector<int>>();
+  match_bid = std::vector<int>();
+  match_ask = std::vector<int>();
+  offset = std::vector<double>();
+  dist = std::vector<double>();
+  pred = std::vector<int>();
+}
+
+bool CAMatching::noSideEffects() {
+  if (!compatible_asks.empty()) return false;
+  if (!match_bid.empty()) return false;
+  if (!match_ask.empty()) return false;
+  if (!offset.empty()) return false;
+  if (!dist.empty()) return false;
+  if (!pred.empty()) return false;
+  return noSideEffectsBase();
+}
@@ -0,0 +1,58 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_CA_MATCHING_H_
+#define SRC_CA_MATCHING_H_
+
+#include <vector>
+
+#include "src/ca.h"
+
+// Optimal algorithm: each bid is allocated at most one ask and each ask at
+// most one bid, so the WDP is a maximum-weight bipartite matching with weights
+// v_i - a_j on the compatible pairs. Bids are inserted one at a time along
+// shortest augmenting paths (successive shortest paths with Dijkstra on
+// reduced costs); every bid may also stay unallocated at zero cost.
+class CAMatching : public CA {
+ public:
+  CAMatching(InstancePtr instance_);
+  ~CAMatching();
+
+  bool noSideEffects();
+  void resetAllocation();
+
+ private:
+  void computeAllocation();
+  void augment(unsigned int r);
+
+  // compatible asks of each bid, i.e. the edges of the bipartite graph
+  std::vector<std::vector<int>> compatible_asks;
+
+  // current matching: partner of each bid/ask, or -1 if unmatched
+  std::vector<int> match_bid;
+  std::vector<int> match_ask;
+
+  // a_j - v_j for the dual variables v_j of the asks, so that the reduced
+  // costs c_ij - u_i - v_j = offset_j - v_i - u_i of the edges are >= 0
+  std::vector<double> offset;
+
+  // shortest path distances and predecessor bids of the asks
+  std::vector<double> dist;
+  std::vector<int> pred;
+};
+
+#endif  // SRC_CA_MATCHING_H_
@@ -17,18 +17,17 @@
 
 #include "ca_sa.h"
 
-CASA::CASA(Instance instance_)
+CASA::CASA(InstancePtr instance_)
     : CA(instance_),
-      z(instance_.getAsks().N(), 0),
-      distribution_neighbor(0, instance_.getBids().N() - 1),
+      z(instance_->getAsks().N(), 0),
+      distribution_neighbor(0, instance_->getBids().N() - 1),
       distribution_ap(0.0, 1.0) {}
 
 CASA::~CASA() {}
 
 void CASA::computeAllocation() {
-  // seed mersenne_twister_engine with rd()
-  std::random_device rd;
-  generator.seed(rd());
+  // seed mersenne_twister_engine with rd(), unless a seed was set
+  generator.seed(nextSeed());
 
   generateInitialSolution();
 
@@ -45,7 +44,11 @@ void CASA::computeAllocation() {
         // flip neighbor bid and ask
         x[neigh.bid] = 1 - x[neigh.bid];
         z[neigh.ask] = 1 - z[neigh.ask];
-        y(neigh.bid, neigh.ask) = 1 - y(neigh.bid, neigh.ask);
+        updateFreeAsk(neigh.ask);
+        if (y(neigh.bid, neigh.ask))
+          y.deallocate(neigh.bid, neigh.ask);
+        else
+          y.allocate(neigh.bid, neigh.ask);
         frozen = false;
         num_frozen_temps = 0;
       }
@@ -62,8 +65,6 @@ double CASA::acceptanceProbability(double new_welfare, double T) {
 }
 
 Neighbor CASA::neighbor() {
-  unsigned int m = instance.getAsks().N();
-
   // compute welfare difference and find which bid and ask have to be flipped
   // change x, y, z only if solution is accepted
   Neighbor neigh;
@@ -74,31 +75,42 @@ Neighbor CASA::neighbor() {
   unsigned int i = distribution_neighbor(generator);
   if (x[i]) {  // if x_i==1 set it to 0
     neigh.welfare -= instance.getBids().V()[i];
-    for (unsigned int j = 0; j < m; ++j) {
-      if (y(i, j)) {
-        neigh.welfare += instance.getAsks().V()[j];
-        neigh.bid = i;
-        neigh.ask = j;
-        neigh.found = true;
-        break;
-      }
-    }
+    neigh.welfare += instance.getAsks().V()[y.askOf(i)];
+    neigh.bid = i;
+    neigh.ask = y.askOf(i);
+    neigh.found = true;
   } else {  // x_i==0, try to find an ask to match from sorted asks
-    for (unsigned int j = 0; j < m; ++j) {
-      // check if seller ask_index[j] can allocate resources to bidder i
-      if (!z[ask_index[j]] && instance.canAllocate(i, ask_index[j])) {
-        neigh.welfare +=
-            instance.getBids().V()[i] - instance.getAsks().V()[ask_index[j]];
-        neigh.bid = i;
-        neigh.ask = ask_index[j];
-        neigh.found = true;
-        break;
-      }
+    int j = firstFreeAsk(i);
+    if (j >= 0) {
+      neigh.welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+      neigh.bid = i;
+      neigh.ask = j;
+      neigh.found = true;
     }
   }
   return neigh;
 }
 
+// @param i the index of the bid
+// @return the first ask with z_j==0 in the order of ask_index that is
+// compatible with bid i, or -1 if none
+int CASA::firstFreeAsk(unsigned int i) {
+  if (!compatible_asks) return free_ask_index.findFirst(instance.getBids(), i);
+  unsigned int p = compatible_asks->first(i, free_asks);
+  return p < compatible_asks->size() ? compatible_asks->at(p) : -1;
+}
+
+// Updates the set of asks with z_j==0 after z_j changed.
+// @param j the index of the ask
+void CASA::updateFreeAsk(int j) {
+  if (compatible_asks)
+    compatible_asks->toggle(free_asks, j);
+  else if (z[j])
+    free_ask_index.erase(j);
+  else
+    free_ask_index.insert(j);
+}
+
 void CASA::generateInitialSolution() {
   unsigned int n = instance.getBids().N();
   unsigned int m = instance.getAsks().N();
@@ -114,6 +126,14 @@ void CASA::generateInitialSolution() {
               return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
             });
 
+  // compatible asks in the same order, all unallocated
+  if (instance.indexedLazily()) {
+    free_ask_index = FreeAskIndex(instance.getAsks(), ask_index);
+  } else {
+    compatible_asks = instance.orderedCompatibility(true, ask_index);
+    free_asks = compatible_asks->all();
+  }
+
   // starting temperature is the maximum possible welfare increase TODO: is this
   // correct? T_max = instance.getBids().V()[bid_index[0]] -
   //         instance.getAsks().V()[ask_index[0]];
@@ -131,7 +151,8 @@ void CASA::generateInitialSolution() {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
       z[ask_index[j]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      updateFreeAsk(ask_index[j]);
+      y.allocate(bid_index[i], ask_index[j]);
       welfare += instance.getBids().V()[bid_index[i]] -
                  instance.getAsks().V()[ask_index[j]];
       ++i;
@@ -144,6 +165,9 @@ void CASA::resetAllocation() {
   resetBase();
   welfare = 0.;
   z = std::vector<int>(instance.getAsks().N(), 0);
+  compatible_asks.reset();
+  free_asks.clear();
+  free_ask_index = FreeAskIndex();
 }
 
 bool CASA::noSideEffects() {
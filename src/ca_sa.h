@@ -25,10 +25,12 @@
 #include <vector>
 
 #include "src/ca.h"
+#include "src/free_ask_index.h"
+#include "src/ordered_compatibility.h"
 
 class CASA : public CA {
  public:
-  CASA(Instance instance_);
+  CASA(InstancePtr instance_);
   ~CASA();
   
   bool noSideEffects();
@@ -38,9 +40,18 @@ class CASA : public CA {
   void computeAllocation();
   void generateInitialSolution();
   Neighbor neighbor();
+  int firstFreeAsk(unsigned int i);
+  void updateFreeAsk(int j);
   double acceptanceProbability(double new_welfare, double T);
 
   std::vector<int> z;  // same as x, but for sellers
+  // compatible asks of each bid in the order of ask_index, and the asks
+  // with z_j==0 as a subset of them
+  std::shared_ptr<const OrderedCompatibility> compatible_asks;
+  std::vector<uint64_t> free_asks;
+  // on instances indexed lazily, the bit rows of all bids would not fit, so
+  // the asks with z_j==0 are searched in a FreeAskIndex instead
+  FreeAskIndex free_ask_index;
   double welfare = 0.;
 
   // SA-specific params
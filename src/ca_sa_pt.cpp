@@ -0,0 +1,165 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/ca_sa_pt.h"
+
+#include <algorithm>
+#include <cmath>
+
+CASAPT::CASAPT(InstancePtr instance_) : CA(instance_) {}
+
+CASAPT::~CASAPT() {}
+
+void CASAPT::computeAllocation() {
+  if (instance.getBids().N() == 0 || instance.getAsks().N() == 0) return;
+
+  // sort bids descendingly by density
+  std::sort(bid_index.begin(), bid_index.end(),
+            [&](unsigned int i, unsigned int j) -> bool {
+              return tmp_bids.getDensity()[i] > tmp_bids.getDensity()[j];
+            });
+  // sort asks ascendingly by density
+  std::sort(ask_index.begin(), ask_index.end(),
+            [&](unsigned int i, unsigned int j) -> bool {
+              return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
+            });
+  if (!instance.indexedLazily())
+    compatible_asks = instance.orderedCompatibility(true, ask_index);
+
+  // the hottest chain follows the schedule of SA, starting at the maximum
+  // possible welfare increase; the others are colder by constant factors
+  auto bid_values = instance.getBids().V();
+  auto ask_values = instance.getAsks().V();
+  double T_max = *(std::max_element(bid_values.begin(), bid_values.end())) -
+                 *(std::min_element(ask_values.begin(), ask_values.end()));
+  std::vector<double> T(num_replicas);
+  for (unsigned int k = 0; k < num_replicas; ++k)
+    T[k] = T_max * std::pow(ladder, double(k) / (num_replicas - 1));
+
+  // the generators of the chains are seeded from the one of the exchanges
+  std::mt19937_64 generator(nextSeed());
+  std::uniform_real_distribution<> distribution_ap(0.0, 1.0);
+  std::vector<std::mt19937_64> generators;
+  for (unsigned int k = 0; k < num_replicas; ++k)
+    generators.push_back(std::mt19937_64(generator()));
+
+  std::vector<State> states(num_replicas, initialState());
+  State best = states[0];
+
+  // the calling thread runs a chain too
+  ThreadPool pool(std::min(num_threads, num_replicas) - 1);
+  for (unsigned int round = 0; T[0] > T_min; ++round) {
+    pool.parallelFor(0, num_replicas, [&](unsigned int k) {
+      anneal(states[k], T[k], generators[k]);
+    });
+    for (auto &state : states)
+      if (state.welfare > best.welfare) best = state;
+    // exchange the states of neighboring temperatures, alternately the even
+    // and the odd pairs
+    for (unsigned int k = round % 2; k + 1 < num_replicas; k += 2) {
+      double p = exp((states[k + 1].welfare - states[k].welfare) *
+                     (1. / T[k] - 1. / T[k + 1]));
+      if (p > distribution_ap(generator)) std::swap(states[k], states[k + 1]);
+    }
+    for (auto &t : T) t *= alpha;
+  }
+
+  x = best.x;
+  y = best.y;
+  compatible_asks.reset();
+}
+
+// @return the greedy1 solution, as in CASA
+CASAPT::State CASAPT::initialState() {
+  unsigned int n = instance.getBids().N();
+  unsigned int m = instance.getAsks().N();
+  State state{std::vector<int>(n, 0), std::vector<int>(m, 0), Allocation(n, m),
+              {}, {}, 0.};
+  if (compatible_asks)
+    state.free_asks = compatible_asks->all();
+  else
+    state.free_ask_index = FreeAskIndex(instance.getAsks(), ask_index);
+  unsigned int i = 0;
+  unsigned int j = 0;
+  while (i < n && j < m) {
+    // seller ask_index[j] can allocate resources to bidder bid_index[i]
+    if (instance.canAllocate(bid_index[i], ask_index[j])) {
+      state.x[bid_index[i]] = 1;
+      state.z[ask_index[j]] = 1;
+      updateFreeAsk(state, ask_index[j]);
+      state.y.allocate(bid_index[i], ask_index[j]);
+      state.welfare += instance.getBids().V()[bid_index[i]] -
+                       instance.getAsks().V()[ask_index[j]];
+      ++i;
+    }
+    ++j;
+  }
+  return state;
+}
+
+// Makes the moves of one temperature of CASA: a random bid is removed from
+// the allocation, or inserted with the first free compatible ask.
+void CASAPT::anneal(State &state, double T,
+                    std::mt19937_64 &generator) const {
+  std::uniform_int_distribution<> distribution_neighbor(
+      0, instance.getBids().N() - 1);
+  std::uniform_real_distribution<> distribution_ap(0.0, 1.0);
+  for (unsigned int iter = 0; iter < niter; ++iter) {
+    unsigned int i = distribution_neighbor(generator);
+    int j;
+    double new_welfare = state.welfare;
+    if (state.x[i]) {
+      j = state.y.askOf(i);
+      new_welfare -= instance.getBids().V()[i] - instance.getAsks().V()[j];
+    } else {
+      j = firstFreeAsk(state, i);
+      if (j < 0) continue;
+      new_welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+    }
+    if (exp((new_welfare - state.welfare) / T) <= distribution_ap(generator))
+      continue;
+    state.welfare = new_welfare;
+    // flip bid i and ask j
+    state.x[i] = 1 - state.x[i];
+    state.z[j] = 1 - state.z[j];
+    updateFreeAsk(state, j);
+    if (state.x[i])
+      state.y.allocate(i, j);
+    else
+      state.y.deallocate(i, j);
+  }
+}
+
+// @return the first ask with z_j==0 of a chain in the order of ask_index
+// that is compatible with bid i, or -1 if none
+int CASAPT::firstFreeAsk(const State &state, unsigned int i) const {
+  if (!compatible_asks)
+    return state.free_ask_index.findFirst(instance.getBids(), i);
+  unsigned int p = compatible_asks->first(i, state.free_asks);
+  return p < compatible_asks->size() ? compatible_asks->at(p) : -1;
+}
+
+// Updates the set of asks with z_j==0 of a chain after z_j changed.
+// @param j the index of the ask
+void CASAPT::updateFreeAsk(State &state, int j) const {
+  if (compatible_asks)
+    compatible_asks->toggle(state.free_asks, j);
+  else if (state.z[j])
+    state.free_ask_index.erase(j);
+  else
+    state.free_ask_index.insert(j);
+}
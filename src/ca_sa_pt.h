@@ -0,0 +1,77 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_CA_SA_PT_H_
+#define SRC_CA_SA_PT_H_
+
+#include <random>
+#include <vector>
+
+#include "src/ca.h"
+#include "src/free_ask_index.h"
+#include "src/ordered_compatibility.h"
+#include "src/thread_pool.h"
+
+// Simulated annealing with parallel tempering (replica exchange): chains at
+// a geometric ladder of temperatures, all starting from the greedy1
+// solution. In each round, every chain makes the moves of SA at its
+// temperature, the chains running concurrently; then the states of
+// neighboring temperatures are exchanged with the Metropolis probability,
+// and the ladder is cooled as in SA. The best state at the end of a round is
+// kept. Each chain has its own generator, so the result does not depend on
+// the number of threads.
+//
+// Chains at fixed temperatures between the start and end temperatures of SA
+// did worse than a single SA chain on the test dataset; cooling the ladder
+// keeps the annealing of SA.
+class CASAPT : public CA {
+ public:
+  CASAPT(InstancePtr instance_);
+  ~CASAPT();
+
+ private:
+  // state of a chain
+  struct State {
+    std::vector<int> x;  // xi
+    std::vector<int> z;  // same as x, but for sellers
+    Allocation y;
+    std::vector<uint64_t> free_asks;  // asks with z_j==0, see CASA
+    FreeAskIndex free_ask_index;      // same, on instances indexed lazily
+    double welfare;
+  };
+
+  void computeAllocation();
+  State initialState();
+  void anneal(State &state, double T, std::mt19937_64 &generator) const;
+  int firstFreeAsk(const State &state, unsigned int i) const;
+  void updateFreeAsk(State &state, int j) const;
+
+  // compatible asks of each bid in the order of ask_index, shared by the
+  // chains; none on instances indexed lazily, as in CASA
+  std::shared_ptr<const OrderedCompatibility> compatible_asks;
+
+  // SA-specific params, as in CASA; the rounds end when the hottest chain
+  // reaches T_min
+  const double T_min = 0.00001;
+  const double alpha = 0.9;
+  const unsigned int niter = 100;
+  // number of chains, and ratio of the coldest to the hottest temperature
+  const unsigned int num_replicas = 8;
+  const double ladder = 0.1;
+};
+
+#endif  // SRC_CA_SA_PT_H_
@@ -17,18 +17,17 @@
 
 #include "ca_sa_s.h"
 
-CASAS::CASAS(Instance instance_)
+CASAS::CASAS(InstancePtr instance_)
     : CA(instance_),
-      z(instance_.getAsks().N(), 0),
-      distribution_neighbor(0, instance_.getAsks().N() - 1),
+      z(instance_->getAsks().N(), 0),
+      distribution_neighbor(0, instance_->getAsks().N() - 1),
       distribution_ap(0.0, 1.0) {}
 
 CASAS::~CASAS() {}
 
 void CASAS::computeAllocation() {
-  // seed mersenne_twister_engine with rd()
-  std::random_device rd;
-  generator.seed(rd());
+  // seed mersenne_twister_engine with rd(), unless a seed was set
+  generator.seed(nextSeed());
 
   generateInitialSolution();
 
@@ -45,7 +44,11 @@ void CASAS::computeAllocation() {
         // flip neighbor bid and ask
         x[neigh.bid] = 1 - x[neigh.bid];
         z[neigh.ask] = 1 - z[neigh.ask];
-        y(neigh.bid, neigh.ask) = 1 - y(neigh.bid, neigh.ask);
+        compatible_bids->toggle(free_bids, neigh.bid);
+        if (y(neigh.bid, neigh.ask))
+          y.deallocate(neigh.bid, neigh.ask);
+        else
+          y.allocate(neigh.bid, neigh.ask);
         frozen = false;
         num_frozen_temps = 0;
       }
@@ -62,8 +65,6 @@ double CASAS::acceptanceProbability(double new_welfare, double T) {
 }
 
 Neighbor CASAS::neighbor() {
-  unsigned int n = instance.getBids().N();
-
   // compute welfare difference and find which bid and ask have to be flipped
   // change x, y, z only if solution is accepted
   Neighbor neigh;
@@ -74,26 +75,18 @@ Neighbor CASAS::neighbor() {
   unsigned int j = distribution_neighbor(generator);
   if (z[j]) {  // if z_j==1 set it to 0
     neigh.welfare += instance.getAsks().V()[j];
-    for (unsigned int i = 0; i < n; ++i) {
-      if (y(i, j)) {
-        neigh.welfare -= instance.getBids().V()[i];
-        neigh.bid = i;
-        neigh.ask = j;
-        neigh.found = true;
-        break;
-      }
-    }
+    neigh.welfare -= instance.getBids().V()[y.bidOf(j)];
+    neigh.bid = y.bidOf(j);
+    neigh.ask = j;
+    neigh.found = true;
   } else {  // z_j==0, try to find a match in the sorted bids
-    for (unsigned int i = 0; i < n; ++i) {
-      // check if seller j can allocate resources to bidder bid_index[i]
-      if (!x[bid_index[i]] && instance.canAllocate(bid_index[i], j)) {
-        neigh.welfare +=
-            instance.getBids().V()[bid_index[i]] - instance.getAsks().V()[j];
-        neigh.bid = bid_index[i];
-        neigh.ask = j;
-        neigh.found = true;
-        break;
-      }
+    unsigned int p = compatible_bids->first(j, free_bids);
+    if (p < compatible_bids->size()) {
+      int i = compatible_bids->at(p);
+      neigh.welfare += instance.getBids().V()[i] - instance.getAsks().V()[j];
+      neigh.bid = i;
+      neigh.ask = j;
+      neigh.found = true;
     }
   }
   return neigh;
@@ -114,6 +107,10 @@ void CASAS::generateInitialSolution() {
               return tmp_asks.getDensity()[i] < tmp_asks.getDensity()[j];
             });
 
+  // compatible bids in the same order, all unallocated
+  compatible_bids = instance.orderedCompatibility(false, bid_index);
+  free_bids = compatible_bids->all();
+
   // starting temperature is the maximum possible welfare increase
   // T_max = instance.getBids().V()[bid_index[0]] -
   //         instance.getAsks().V()[ask_index[0]];
@@ -131,7 +128,8 @@ void CASAS::generateInitialSolution() {
     if (instance.canAllocate(bid_index[i], ask_index[j])) {
       x[bid_index[i]] = 1;
       z[ask_index[j]] = 1;
-      y(bid_index[i], ask_index[j]) = 1;
+      compatible_bids->toggle(free_bids, bid_index[i]);
+      y.allocate(bid_index[i], ask_index[j]);
       welfare += instance.getBids().V()[bid_index[i]] -
                  instance.getAsks().V()[ask_index[j]];
       ++j;
@@ -144,6 +142,8 @@ void CASAS::resetAllocation() {
   resetBase();
   welfare = 0.;
   z = std::vector<int>(instance.getAsks().N(), 0);
+  compatible_bids.reset();
+  free_bids.clear();
 }
 
 bool CASAS::noSideEffects() {
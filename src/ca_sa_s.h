@@ -25,10 +25,11 @@
 #include <vector>
 
 #include "src/ca.h"
+#include "src/ordered_compatibility.h"
 
 class CASAS : public CA {
  public:
-  CASAS(Instance instance_);
+  CASAS(InstancePtr instance_);
   ~CASAS();
 
   bool noSideEffects();
@@ -41,6 +42,10 @@ class CASAS : public CA {
   double acceptanceProbability(double new_welfare, double T);
 
   std::vector<int> z;  // same as x, but for sellers
+  // compatible bids of each ask in the order of bid_index, and the bids with
+  // x_i==0 as a subset of them
+  std::shared_ptr<const OrderedCompatibility> compatible_bids;
+  std::vector<uint64_t> free_bids;
   double welfare = 0.;
 
   // SA-specific params
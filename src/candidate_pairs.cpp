@@ -0,0 +1,78 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/candidate_pairs.h"
+
+CandidatePairs::CandidatePairs(const Instance &instance_,
+                               bool leaders_are_bids_,
+                               const std::vector<int> &followers)
+    : instance(&instance_),
+      leaders_are_bids(leaders_are_bids_),
+      compatibility(
+          instance_.orderedCompatibility(leaders_are_bids_, followers)) {
+  unsigned int num_leaders = leaders_are_bids ? instance->getBids().N()
+                                              : instance->getAsks().N();
+  free = compatibility->all();
+  allocated.assign(num_leaders, 0);
+  pointer.assign(num_leaders, compatibility->size());
+  waiting.resize(compatibility->size());
+  slot.assign(num_leaders, -1);
+  for (unsigned int x = 0; x < num_leaders; ++x)
+    propose(x, compatibility->first(x, free));
+}
+
+void CandidatePairs::allocate(int x) {
+  unsigned int p = pointer[x];
+  allocated[x] = 1;
+  remove(x);
+  compatibility->toggle(free, compatibility->at(p));
+  // the other leaders waiting for this follower move on to their next free
+  // compatible one
+  std::vector<int> moving;
+  moving.swap(waiting[p]);
+  for (int other : moving) {
+    if (allocated[other]) continue;
+    remove(other);
+    propose(other, compatibility->next(other, p + 1, free));
+  }
+}
+
+// Proposes leader x with the follower at position p, if any, and makes it a
+// candidate if the pair has a positive welfare.
+void CandidatePairs::propose(int x, unsigned int p) {
+  pointer[x] = p;
+  if (p >= compatibility->size()) return;
+  waiting[p].push_back(x);
+  int y = compatibility->at(p);
+  double gain = leaders_are_bids
+                    ? instance->getBids().V()[x] - instance->getAsks().V()[y]
+                    : instance->getBids().V()[y] - instance->getAsks().V()[x];
+  if (gain <= 0) return;
+  slot[x] = candidates.size();
+  candidates.push_back(x);
+}
+
+// Removes leader x from the candidates, if it is one.
+void CandidatePairs::remove(int x) {
+  if (slot[x] < 0) return;
+  // move the last candidate to the slot of x
+  int last = candidates.back();
+  candidates[slot[x]] = last;
+  slot[last] = slot[x];
+  candidates.pop_back();
+  slot[x] = -1;
+}
@@ -0,0 +1,72 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_CANDIDATE_PAIRS_H_
+#define SRC_CANDIDATE_PAIRS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "src/instance.h"
+#include "src/ordered_compatibility.h"
+
+// Improving moves of the toggling hill climbers, which only add pairs to
+// the allocation: an unallocated leader (a bid, or an ask) is proposed with
+// the first free compatible follower in a fixed order, and the move is
+// improving if the pair has a positive welfare. The first free follower of
+// each leader and the set of leaders with an improving move are kept up to
+// date as pairs are allocated, since the first free follower only changes
+// when it is allocated.
+class CandidatePairs {
+ public:
+  CandidatePairs() {}
+  // @param leaders_are_bids whether the leaders are the bids or the asks
+  // @param followers the order of the other side
+  CandidatePairs(const Instance &instance, bool leaders_are_bids,
+                 const std::vector<int> &followers);
+
+  // number of leaders with an improving move
+  inline unsigned int size() const { return candidates.size(); }
+  // @return the leader with an improving move at index r < size(), in no
+  // particular order
+  inline int leader(unsigned int r) const { return candidates[r]; }
+  // @return the follower proposed for leader x
+  inline int partner(int x) const { return compatibility->at(pointer[x]); }
+
+  // allocates leader x with its partner
+  void allocate(int x);
+
+ private:
+  void propose(int x, unsigned int p);
+  void remove(int x);
+
+  const Instance *instance = nullptr;
+  bool leaders_are_bids = true;
+  // rows are the leaders
+  std::shared_ptr<const OrderedCompatibility> compatibility;
+  std::vector<uint64_t> free;          // free followers
+  std::vector<char> allocated;         // allocated leaders
+  // first free compatible follower of each leader, as a position, and the
+  // leaders proposed with the follower at each position
+  std::vector<unsigned int> pointer;
+  std::vector<std::vector<int>> waiting;
+  // leaders with an improving move, and the index of each in it, or -1
+  std::vector<int> candidates;
+  std::vector<int> slot;
+};
+
+#endif  // SRC_CANDIDATE_PAIRS_H_
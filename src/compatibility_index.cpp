@@ -0,0 +1,86 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/compatibility_index.h"
+
+#include <algorithm>
+#include <limits>
+
+// number of 64-bit words (i.e. 64 asks) processed for all bids at once
+#define BLOCK_WORDS 16
+
+CompatibilityIndex::CompatibilityIndex(const BidSet &bids, const BidSet &asks,
+                                       bool lazy_)
+    : n(bids.N()),
+      m(asks.N()),
+      l(bids.L()),
+      words((asks.N() + 63) / 64),
+      lazy(lazy_),
+      bid_q(n * l),
+      bid_v(bids.V()),
+      ask_q(l * words * 64, 0),
+      ask_v(words * 64, std::numeric_limits<double>::infinity()),
+      bits(lazy_ ? 0 : n * words, 0) {
+  for (unsigned int i = 0; i < n; ++i)
+    std::copy_n(bids.row(i), l, bid_q.begin() + i * l);
+  for (unsigned int j = 0; j < m; ++j) {
+    ask_v[j] = asks.V()[j];
+    for (unsigned int k = 0; k < l; ++k)
+      ask_q[k * words * 64 + j] = asks.Q()(j, k);
+  }
+
+  if (lazy) {
+    rows.resize(n);
+    row_once.reset(new std::once_flag[n]);
+    return;
+  }
+  // blocks of asks stay in cache while all bids are compared against them
+  for (unsigned int w0 = 0; w0 < words; w0 += BLOCK_WORDS) {
+    unsigned int w1 = std::min(words, w0 + BLOCK_WORDS);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int w = w0; w < w1; ++w)
+        bits[i * words + w] = computeWord(i, w);
+  }
+}
+
+std::size_t CompatibilityIndex::memoryUsage() const {
+  return bid_q.size() * sizeof(unsigned int) + bid_v.size() * sizeof(double) +
+         ask_q.size() * sizeof(unsigned int) + ask_v.size() * sizeof(double) +
+         bits.size() * sizeof(uint64_t) +
+         rows.size() * sizeof(std::vector<uint64_t>) +
+         rows_computed * words * sizeof(uint64_t);
+}
+
+void CompatibilityIndex::computeRow(unsigned int i) {
+  rows[i].resize(words);
+  for (unsigned int w = 0; w < words; ++w) rows[i][w] = computeWord(i, w);
+  ++rows_computed;
+}
+
+// Compares bid i with the 64 asks of word w.
+// @param i the index of the bid
+// @param w the index of the word
+// @return bit j is set if ask 64 * w + j is compatible
+uint64_t CompatibilityIndex::computeWord(unsigned int i, unsigned int w) {
+  const double *v = &ask_v[w * 64];
+
+  // same conditions as Instance::canAllocate
+  uint64_t word = dominatesBlock(&bid_q[i * l], l, &ask_q[w * 64], words * 64);
+  for (unsigned int a = 0; a < 64; ++a)
+    if (bid_v[i] < v[a]) word &= ~((uint64_t)1 << a);
+  return word;
+}
@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_COMPATIBILITY_INDEX_H_
+#define SRC_COMPATIBILITY_INDEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "src/bid_set.h"
+#include "src/dominance.h"
+
+// n x m bit matrix telling which bid can be allocated to which ask.
+// The eager variant computes all rows at construction, ask block by ask
+// block; the lazy variant computes a row the first time it is queried, so
+// that only the rows of the bids actually looked at are stored.
+class CompatibilityIndex {
+ public:
+  CompatibilityIndex(const BidSet &bids, const BidSet &asks, bool lazy);
+
+  inline bool get(unsigned int i, unsigned int j) {
+    const uint64_t *r = row(i);
+    return (r[j / 64] >> (j % 64)) & 1;
+  }
+
+  // bit row of bid i: ask j is compatible if bit j % 64 of word j / 64 is set
+  inline const uint64_t *row(unsigned int i) {
+    if (!lazy) return &bits[i * words];
+    std::call_once(row_once[i], [this, i]() { computeRow(i); });
+    return rows[i].data();
+  }
+
+  inline unsigned int N() const { return n; }
+  inline unsigned int M() const { return m; }
+  inline unsigned int W() const { return words; }  // 64-bit words per row
+
+  // bytes held by the index, with the lazy rows computed so far
+  std::size_t memoryUsage() const;
+
+ private:
+  void computeRow(unsigned int i);
+  uint64_t computeWord(unsigned int i, unsigned int w);
+
+  unsigned int n, m, l, words;
+  bool lazy;
+
+  // copies of the bids, since the index is shared between copies of an
+  // instance and may outlive the one it was built from
+  std::vector<unsigned int> bid_q;  // bid_q[i * l + k]
+  std::vector<double> bid_v;
+
+  // asks stored resource by resource, padded to a multiple of 64 asks; the
+  // padding asks have an infinite value and are never compatible
+  AlignedVector<unsigned int> ask_q;  // ask_q[k * words * 64 + j]
+  std::vector<double> ask_v;
+
+  std::vector<uint64_t> bits;  // eager variant: all rows, row after row
+
+  // lazy variant: rows computed so far; rows can be queried concurrently
+  std::vector<std::vector<uint64_t>> rows;
+  std::unique_ptr<std::once_flag[]> row_once;
+  std::atomic<std::size_t> rows_computed{0};
+};
+
+#endif  // SRC_COMPATIBILITY_INDEX_H_
@@ -0,0 +1,120 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/dominance.h"
+
+#include <immintrin.h>
+
+namespace {
+
+bool dominatesScalar(const unsigned int *ask, const unsigned int *bid,
+                     unsigned int length) {
+  for (unsigned int k = 0; k < length; ++k)
+    if (bid[k] > ask[k]) return false;
+  return true;
+}
+
+uint64_t dominatesBlockScalar(const unsigned int *bid, unsigned int l,
+                              const unsigned int *asks, unsigned int stride) {
+  uint8_t ok[64];
+  for (unsigned int a = 0; a < 64; ++a) ok[a] = 1;
+  for (unsigned int k = 0; k < l; ++k)
+    for (unsigned int a = 0; a < 64; ++a)
+      ok[a] &= bid[k] <= asks[k * stride + a];
+  uint64_t mask = 0;
+  for (unsigned int a = 0; a < 64; ++a) mask |= (uint64_t)ok[a] << a;
+  return mask;
+}
+
+// AVX2 has no unsigned comparison: b <= a if and only if max(a, b) == a
+__attribute__((target("avx2"))) bool dominatesAVX2(const unsigned int *ask,
+                                                   const unsigned int *bid,
+                                                   unsigned int length) {
+  for (unsigned int k = 0; k < length; k += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(ask + k));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(bid + k));
+    __m256i ok = _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a);
+    if (_mm256_movemask_epi8(ok) != -1) return false;
+  }
+  return true;
+}
+
+__attribute__((target("avx2"))) uint64_t dominatesBlockAVX2(
+    const unsigned int *bid, unsigned int l, const unsigned int *asks,
+    unsigned int stride) {
+  __m256i ok[8];
+  for (unsigned int v = 0; v < 8; ++v) ok[v] = _mm256_set1_epi32(-1);
+  for (unsigned int k = 0; k < l; ++k) {
+    __m256i b = _mm256_set1_epi32(bid[k]);
+    for (unsigned int v = 0; v < 8; ++v) {
+      const unsigned int *q = asks + k * stride + 8 * v;
+      __m256i a = _mm256_loadu_si256((const __m256i *)q);
+      ok[v] = _mm256_and_si256(ok[v],
+                               _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a));
+    }
+  }
+  uint64_t mask = 0;
+  for (unsigned int v = 0; v < 8; ++v)
+    mask |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(ok[v]))
+            << (8 * v);
+  return mask;
+}
+
+__attribute__((target("avx512f"))) uint64_t dominatesBlockAVX512(
+    const unsigned int *bid, unsigned int l, const unsigned int *asks,
+    unsigned int stride) {
+  __mmask16 ok[4] = {0xffff, 0xffff, 0xffff, 0xffff};
+  for (unsigned int k = 0; k < l; ++k) {
+    __m512i b = _mm512_set1_epi32(bid[k]);
+    for (unsigned int v = 0; v < 4; ++v) {
+      __m512i a = _mm512_loadu_si512(asks + k * stride + 16 * v);
+      ok[v] = _mm512_mask_cmple_epu32_mask(ok[v], b, a);
+    }
+  }
+  uint64_t mask = 0;
+  for (unsigned int v = 0; v < 4; ++v) mask |= (uint64_t)ok[v] << (16 * v);
+  return mask;
+}
+
+const DominanceKernels &kernels() {
+  static const DominanceKernels k = supportedDominanceKernels().back();
+  return k;
+}
+
+}  // namespace
+
+bool dominates(const unsigned int *ask, const unsigned int *bid,
+               unsigned int length) {
+  return kernels().pair(ask, bid, length);
+}
+
+uint64_t dominatesBlock(const unsigned int *bid, unsigned int l,
+                        const unsigned int *asks, unsigned int stride) {
+  return kernels().block(bid, l, asks, stride);
+}
+
+std::vector<DominanceKernels> supportedDominanceKernels() {
+  std::vector<DominanceKernels> supported = {
+      {dominatesScalar, dominatesBlockScalar, "scalar"}};
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    supported.push_back({dominatesAVX2, dominatesBlockAVX2, "avx2"});
+  // the pair kernel stays the AVX2 one
+  if (__builtin_cpu_supports("avx512f"))
+    supported.push_back({dominatesAVX2, dominatesBlockAVX512, "avx512"});
+  return supported;
+}
@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_DOMINANCE_H_
+#define SRC_DOMINANCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Kernels checking whether asks offer at least the quantities requested by
+// a bid. The SIMD variant (AVX-512, AVX2 or scalar) is chosen at runtime,
+// according to the instructions supported by the CPU.
+
+// allocator returning memory aligned to a cache line
+template <class T>
+struct AlignedAllocator {
+  typedef T value_type;
+  static const std::size_t alignment = 64;
+
+  AlignedAllocator() {}
+  template <class U>
+  AlignedAllocator(const AlignedAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    std::size_t bytes = (n * sizeof(T) + alignment - 1) / alignment * alignment;
+    void *p = std::aligned_alloc(alignment, bytes ? bytes : alignment);
+    if (!p) throw std::bad_alloc();
+    return static_cast<T *>(p);
+  }
+  void deallocate(T *p, std::size_t) { std::free(p); }
+
+  template <class U>
+  bool operator==(const AlignedAllocator<U> &) const { return true; }
+  template <class U>
+  bool operator!=(const AlignedAllocator<U> &) const { return false; }
+};
+
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// quantity rows are padded with zeros to a multiple of 8 resources
+inline unsigned int paddedLength(unsigned int l) { return (l + 7) / 8 * 8; }
+
+// @param ask padded quantity row of the ask
+// @param bid padded quantity row of the bid
+// @param length padded length of both rows
+// @return true if ask[k] >= bid[k] for all k
+bool dominates(const unsigned int *ask, const unsigned int *bid,
+               unsigned int length);
+
+// Compares one bid with a block of 64 asks stored resource by resource.
+// @param bid quantity row of the bid
+// @param l number of resources
+// @param asks quantities of the asks, asks[k * stride + a] for ask a
+// @param stride distance between the rows of two resources, a multiple of 16
+// @return bit a is set if ask a offers at least the quantities of the bid
+uint64_t dominatesBlock(const unsigned int *bid, unsigned int l,
+                        const unsigned int *asks, unsigned int stride);
+
+// one variant of the kernels above
+struct DominanceKernels {
+  bool (*pair)(const unsigned int *, const unsigned int *, unsigned int);
+  uint64_t (*block)(const unsigned int *, unsigned int, const unsigned int *,
+                    unsigned int);
+  const char *name;  // "avx512", "avx2" or "scalar"
+};
+
+// @return the variants supported by the CPU, the one in use last
+std::vector<DominanceKernels> supportedDominanceKernels();
+
+#endif  // SRC_DOMINANCE_H_
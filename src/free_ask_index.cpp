@@ -0,0 +1,102 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/free_ask_index.h"
+
+#include <algorithm>
+#include <limits>
+
+FreeAskIndex::FreeAskIndex(const BidSet &asks, const std::vector<int> &order_)
+    : stride(asks.S()), leaves(1), order(order_), position(asks.N()) {
+  while (leaves < order.size()) leaves *= 2;
+
+  ask_v.resize(order.size());
+  ask_q.resize(order.size() * stride);
+  for (unsigned int p = 0; p < order.size(); ++p) {
+    position[order[p]] = p;
+    ask_v[p] = asks.V()[order[p]];
+    for (unsigned int k = 0; k < stride; ++k)
+      ask_q[p * stride + k] = asks.row(order[p])[k];
+  }
+
+  count.resize(2 * leaves);
+  min_v.resize(2 * leaves);
+  max_q.resize(2 * leaves * stride);
+  reset();
+}
+
+void FreeAskIndex::reset() {
+  for (unsigned int p = 0; p < leaves; ++p) {
+    unsigned int node = leaves + p;
+    bool free = p < order.size();
+    count[node] = free;
+    min_v[node] = free ? ask_v[p] : std::numeric_limits<double>::infinity();
+    for (unsigned int k = 0; k < stride; ++k)
+      max_q[node * stride + k] = free ? ask_q[p * stride + k] : 0;
+  }
+  for (unsigned int node = leaves - 1; node > 0; --node) pull(node);
+}
+
+void FreeAskIndex::insert(int j) { set(j, true); }
+
+void FreeAskIndex::erase(int j) { set(j, false); }
+
+// Updates the leaf of ask j and all its ancestors.
+// @param j the index of the ask
+// @param free whether ask j becomes free or allocated
+void FreeAskIndex::set(int j, bool free) {
+  unsigned int p = position[j];
+  unsigned int node = leaves + p;
+  count[node] = free;
+  min_v[node] = free ? ask_v[p] : std::numeric_limits<double>::infinity();
+  for (unsigned int k = 0; k < stride; ++k)
+    max_q[node * stride + k] = free ? ask_q[p * stride + k] : 0;
+  for (node /= 2; node > 0; node /= 2) pull(node);
+}
+
+// Recomputes an inner node from its children; children without free asks
+// hold an infinite value and zero quantities, so they do not contribute.
+// @param node the index of the node
+void FreeAskIndex::pull(unsigned int node) {
+  unsigned int a = 2 * node, b = 2 * node + 1;
+  count[node] = count[a] + count[b];
+  min_v[node] = std::min(min_v[a], min_v[b]);
+  for (unsigned int k = 0; k < stride; ++k)
+    max_q[node * stride + k] =
+        std::max(max_q[a * stride + k], max_q[b * stride + k]);
+}
+
+int FreeAskIndex::findFirst(const BidSet &bids, unsigned int i) const {
+  if (size() == 0) return -1;
+  return find(1, bids.V()[i], bids.row(i));
+}
+
+// Leftmost free ask below the given node that is compatible with a bid.
+// Since the node bounds are exact at the leaves, no other check is needed.
+// @param node the index of the node
+// @param value the bid value
+// @param q the padded quantity row of the bid
+// @return the index of the ask, or -1 if none
+int FreeAskIndex::find(unsigned int node, double value,
+                       const unsigned int *q) const {
+  if (count[node] == 0 || min_v[node] > value) return -1;
+  if (!dominates(&max_q[node * stride], q, stride)) return -1;
+  if (node >= leaves) return order[node - leaves];
+  int j = find(2 * node, value, q);
+  if (j >= 0) return j;
+  return find(2 * node + 1, value, q);
+}
@@ -0,0 +1,67 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_FREE_ASK_INDEX_H_
+#define SRC_FREE_ASK_INDEX_H_
+
+#include <vector>
+
+#include "src/bid_set.h"
+
+// Dynamic set of free asks, kept in a fixed order (e.g. ascending density).
+// findFirst returns the first free ask in this order that can be allocated
+// to a bid, i.e. that asks at most the bid value and offers at least the
+// requested quantities. The asks are the leaves of a segment tree whose
+// nodes hold the number of free asks, their minimum value and the
+// componentwise maximum of their quantities; subtrees that cannot contain
+// a feasible ask are skipped.
+class FreeAskIndex {
+ public:
+  FreeAskIndex() {}
+  FreeAskIndex(const BidSet &asks, const std::vector<int> &order);
+
+  void reset();  // marks all asks free
+  void insert(int j);
+  void erase(int j);
+  inline bool contains(int j) const { return count[leaf(j)] > 0; }
+  inline unsigned int size() const { return count.empty() ? 0 : count[1]; }
+
+  // @return the first free ask compatible with bid i, or -1 if none
+  int findFirst(const BidSet &bids, unsigned int i) const;
+
+ private:
+  inline unsigned int leaf(int j) const { return leaves + position[j]; }
+  void set(int j, bool free);
+  void pull(unsigned int node);
+  int find(unsigned int node, double value, const unsigned int *q) const;
+
+  unsigned int stride = 0;     // padded number of resources
+  unsigned int leaves = 0;     // number of leaves, a power of 2
+  std::vector<int> order;      // ask at each position
+  std::vector<int> position;   // position of each ask
+
+  // ask data, by position
+  std::vector<double> ask_v;
+  std::vector<unsigned int> ask_q;  // ask_q[p * stride + k]
+
+  // nodes in heap layout: the root is 1, the children of k are 2k and 2k+1
+  std::vector<unsigned int> count;
+  std::vector<double> min_v;
+  AlignedVector<unsigned int> max_q;  // max_q[node * stride + k]
+};
+
+#endif  // SRC_FREE_ASK_INDEX_H_
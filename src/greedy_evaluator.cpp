@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/greedy_evaluator.h"
+
+#include <algorithm>
+
+GreedyEvaluator::GreedyEvaluator(const Instance &instance_,
+                                 bool leaders_are_bids_,
+                                 const std::vector<int> &followers)
+    : instance(&instance_),
+      leaders_are_bids(leaders_are_bids_),
+      compatibility(
+          instance_.orderedCompatibility(leaders_are_bids_, followers)) {}
+
+double GreedyEvaluator::checkpoint(const std::vector<int> &leaders_,
+                                   unsigned int &critical) {
+  leaders = leaders_;
+  unsigned int n = leaders.size();
+  unsigned int m = compatibility->size();
+  pointer.assign(n + 1, m);
+  first_allocated.assign(n + 1, 0);
+  gains.clear();
+
+  double welfare = 0.;
+  critical = 0;
+  unsigned int p = 0;
+  for (unsigned int k = 0; k < n; ++k) {
+    pointer[k] = p;
+    first_allocated[k] = gains.size();
+    if (p >= m) continue;
+    unsigned int q = compatibility->next(leaders[k], p);
+    if (q >= m) {
+      p = m;
+      continue;
+    }
+    double g = gain(leaders[k], q);
+    welfare += g;
+    gains.push_back(g);
+    critical = k;
+    p = q + 1;
+  }
+  pointer[n] = p;
+  first_allocated[n] = gains.size();
+  return welfare;
+}
+
+double GreedyEvaluator::rotatedWelfare(unsigned int first,
+                                       unsigned int last) const {
+  unsigned int n = leaders.size();
+  unsigned int m = compatibility->size();
+  double welfare = 0.;
+  unsigned int p = 0;
+
+  // allocates leader x
+  // @return false once the allocation stops
+  auto allocate = [&](int x) -> bool {
+    unsigned int q = compatibility->next(x, p);
+    if (q >= m) return false;
+    welfare += gain(x, q);
+    p = q + 1;
+    return p < m;
+  };
+  // takes the allocations of the checkpointed run at positions [from, to)
+  auto resume = [&](unsigned int from, unsigned int to) {
+    for (unsigned int a = first_allocated[from]; a < first_allocated[to]; ++a)
+      welfare += gains[a];
+    p = pointer[to];
+  };
+
+  // the moved leaders, in reverse order
+  for (unsigned int k = last + 1; k-- > first;)
+    if (!allocate(leaders[k])) return welfare;
+  // the leaders before them, shifted back; same allocation as the checkpoint
+  // once the follower pointer is the same
+  for (unsigned int k = 0; k < first; ++k) {
+    if (p == pointer[k]) {
+      resume(k, first);
+      break;
+    }
+    if (!allocate(leaders[k])) return welfare;
+  }
+  if (p >= m) return welfare;
+  // the leaders after them, in place
+  for (unsigned int k = last + 1; k < n; ++k) {
+    if (p == pointer[k]) {
+      resume(k, n);
+      return welfare;
+    }
+    if (!allocate(leaders[k])) return welfare;
+  }
+  return welfare;
+}
+
+unsigned int GreedyEvaluator::firstImprovement(unsigned int first,
+                                               double welfare,
+                                               ThreadPool &pool) const {
+  unsigned int n = leaders.size();
+  // a sequential search stops at the first improvement
+  unsigned int block = pool.size() == 0 ? 1 : block_size * (pool.size() + 1);
+  std::vector<double> welfares(block);
+  for (unsigned int begin = first; begin < n; begin += block) {
+    unsigned int end = std::min(n, begin + block);
+    pool.parallelFor(begin, end, [&](unsigned int last) {
+      welfares[last - begin] = rotatedWelfare(first, last);
+    });
+    for (unsigned int last = begin; last < end; ++last)
+      if (welfares[last - begin] > welfare) return last;
+  }
+  return n;
+}
+
+void GreedyEvaluator::rotate(std::vector<int> &leaders, unsigned int first,
+                             unsigned int last) {
+  std::reverse(leaders.begin() + first, leaders.begin() + last + 1);
+  std::rotate(leaders.begin(), leaders.begin() + first,
+              leaders.begin() + last + 1);
+}
+
+double GreedyEvaluator::gain(int x, unsigned int p) const {
+  if (leaders_are_bids)
+    return instance->getBids().V()[x] -
+           instance->getAsks().V()[compatibility->at(p)];
+  return instance->getBids().V()[compatibility->at(p)] -
+         instance->getAsks().V()[x];
+}
@@ -0,0 +1,89 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_GREEDY_EVALUATOR_H_
+#define SRC_GREEDY_EVALUATOR_H_
+
+#include <vector>
+
+#include "src/instance.h"
+#include "src/ordered_compatibility.h"
+#include "src/thread_pool.h"
+
+// Welfare of the greedy allocation used by the HILL1 algorithms: the leaders
+// (bids, or asks for HILL1S) are taken in a given order, and each one gets
+// the first compatible follower after the follower of the previous leader;
+// the allocation stops at the first leader without such a follower.
+//
+// The run along an ordering is checkpointed (follower pointer and welfare
+// at every position). Orderings obtained by moving some leaders to the front
+// are then evaluated by simulating the moved leaders only, and the rest until
+// the follower pointer meets the checkpointed run again; from there on, the
+// allocation is the same. Welfare is summed in the same order as a full run,
+// so the results are identical. Evaluations only read the checkpoint, so
+// several of them may run concurrently.
+class GreedyEvaluator {
+ public:
+  GreedyEvaluator() {}
+  // @param leaders_are_bids whether the leaders are the bids or the asks
+  // @param followers the fixed order of the other side
+  GreedyEvaluator(const Instance &instance, bool leaders_are_bids,
+                  const std::vector<int> &followers);
+
+  // Runs the allocation along an ordering and keeps it as the checkpoint.
+  // @param critical set to the position of the last allocated leader, or 0
+  // @return the welfare
+  double checkpoint(const std::vector<int> &leaders, unsigned int &critical);
+
+  // Evaluates the ordering obtained from the checkpointed one by moving the
+  // leaders at positions first, ..., last to the front one after the other,
+  // i.e. they come first, in reverse order.
+  // @return the welfare
+  double rotatedWelfare(unsigned int first, unsigned int last) const;
+
+  // Finds the smallest last for which rotatedWelfare(first, last) exceeds a
+  // welfare. Candidates are evaluated concurrently in blocks, block after
+  // block, so the result is the same as that of a sequential search.
+  // @param pool threads helping the calling thread; none for a sequential
+  // search
+  // @return last, or the number of leaders if there is no improvement
+  unsigned int firstImprovement(unsigned int first, double welfare,
+                                ThreadPool &pool) const;
+
+  // applies the move evaluated by rotatedWelfare to an ordering
+  static void rotate(std::vector<int> &leaders, unsigned int first,
+                     unsigned int last);
+
+ private:
+  double gain(int x, unsigned int p) const;
+
+  const Instance *instance = nullptr;
+  bool leaders_are_bids = true;
+  // candidates per thread in a block of firstImprovement
+  static constexpr unsigned int block_size = 8;
+
+  // compatibility of each leader with the followers, in their order
+  std::shared_ptr<const OrderedCompatibility> compatibility;
+
+  // checkpointed run
+  std::vector<int> leaders;
+  std::vector<unsigned int> pointer;  // follower pointer before position k
+  std::vector<double> gains;  // welfare of the allocated leaders, in order
+  std::vector<unsigned int> first_allocated;  // in gains, position >= k
+};
+
+#endif  // SRC_GREEDY_EVALUATOR_H_
@@ -21,13 +21,17 @@
 #include <boost/program_options.hpp>
 #include <iomanip>
 #include <iostream>
+#include <random>
 
 void usage(char* program_name, boost::program_options::options_description desc) {
   std::cout << "Usage: " << program_name << " [-m MODE] [-o OUTFILE] [-i] INFILE(s)" << std::endl
             << "   or: " << program_name << " [-a ALGO] [-o OUTFILE] [-i] INFILE(s)" << std::endl
+            << "   or: " << program_name << " convert INFILE OUTFILE" << std::endl
             << std::endl << "Run algorithm portfolio on auction instance(s) stored in INFILE(s)."
             << std::endl << "By default, the portfolio is run in HEURISTICS mode, and stats are"
             << std::endl << "printed to standard out."
+            << std::endl << "The convert command writes the instance in INFILE to a binary file,"
+            << std::endl << "which is read faster than YAML and can be used as INFILE."
             << std::endl;
 
   std::cout << std::endl << desc << std::endl;
@@ -75,6 +79,8 @@ boost::optional<InputParams> parse(int argc, char* argv[]) {
     InputParams params;
     std::string mode;
     std::string algo;
+    std::string format;
+    std::string pricing;
 
     namespace po = boost::program_options;
     po::options_description desc("Allowed options");
@@ -90,9 +96,40 @@ boost::optional<InputParams> parse(int argc, char* argv[]) {
         ("out,o", po::value<std::string>(&params.outfile)->
                   value_name("OUTFILE"),
                   "output file to store runtime stats")
+        ("format,f", po::value<std::string>(&format)->
+                     default_value(std::string("CSV"))->
+                     value_name("FORMAT"),
+                     "format of the stats: CSV or JSONL")
+        ("pricing,r", po::value<std::string>(&pricing)->
+                      default_value(std::string("K"))->
+                      value_name("PRICING"),
+                      "pricing of the winners: K or VCG")
         ("in,i", po::value<std::vector<std::string>>(&params.infiles)->
                  value_name("INFILE(s)"),
                  "input files, one per auction instance")
+        ("epsilon,e", po::value<double>(&params.epsilon)->
+                      default_value(1e-3)->
+                      value_name("EPS"),
+                      "maximum relative welfare loss of BERTSEKAS")
+        ("threads,t", po::value<unsigned int>(&params.threads)->
+                      default_value(1)->
+                      value_name("N"),
+                      "number of concurrent algorithm runs")
+        ("algo-threads", po::value<unsigned int>(&params.algo_threads)->
+                         default_value(1)->
+                         value_name("N"),
+                         "threads of one algorithm run, with -t 1")
+        ("seed,s", po::value<unsigned long>(&params.seed)->
+                   value_name("SEED"),
+                   "master seed of stochastic algorithms")
+        ("prefetch,p", po::value<unsigned int>(&params.prefetch)->
+                       default_value(1)->
+                       value_name("N"),
+                       "number of instances loaded ahead")
+        ("prefetch-memory", po::value<unsigned long>(&params.prefetch_memory)->
+                            default_value(1024)->
+                            value_name("MB"),
+                            "memory cap of instances loaded ahead")
     ;
     po::positional_options_description p;
     p.add("in", -1);
@@ -119,6 +156,26 @@ boost::optional<InputParams> parse(int argc, char* argv[]) {
         throw std::invalid_argument(std::string("mode ") + mode + " invalid.");
     }
 
+    if (!OutputFormat::_is_valid_nocase(format.c_str()))
+      throw std::invalid_argument(std::string("format ") + format +
+                                  " invalid.");
+
+    if (!PricingMode::_is_valid_nocase(pricing.c_str()))
+      throw std::invalid_argument(std::string("pricing ") + pricing +
+                                  " invalid.");
+
+    if (params.epsilon <= 0.)
+      throw std::invalid_argument(std::string("epsilon must be positive."));
+
+    if (params.threads == 0)
+      throw std::invalid_argument(std::string("threads must be positive."));
+
+    if (params.algo_threads == 0)
+      throw std::invalid_argument(
+          std::string("algo-threads must be positive."));
+
+    if (!vm.count("seed")) params.seed = std::random_device()();
+
     if (vm.count("algo")) {
       // validate algorithm in algo mode
       if (!AuctionType::_is_valid_nocase(algo.c_str()))
@@ -128,6 +185,8 @@ boost::optional<InputParams> parse(int argc, char* argv[]) {
 
     params.mode = RunMode::_from_string_nocase_nothrow(mode.c_str());
     params.algo = AuctionType::_from_string_nocase_nothrow(algo.c_str());
+    params.format = OutputFormat::_from_string_nocase_nothrow(format.c_str());
+    params.pricing = PricingMode::_from_string_nocase_nothrow(pricing.c_str());
 
     return params;
   } catch (std::exception& e) {
@@ -141,7 +200,25 @@ bool isStochastic(AuctionType type) {
   // NOTE: Casanova(s) algos are stochastic, but already use random restarts
   if (type == +AuctionType::HILL2 || type == +AuctionType::HILL2S ||
       type == +AuctionType::SA || type == +AuctionType::SAS ||
+      type == +AuctionType::SAPT ||
       type == +AuctionType::CASANOVA || type == +AuctionType::CASANOVAS)
     return true;
   return false;
-}
\ No newline at end of file
+}
+
+bool isHeuristic(AuctionType type) {
+  // CPLEX, MATCHING and BERTSEKAS are (epsilon-)optimal, RLPS needs the
+  // CPLEX library
+  if (type == +AuctionType::CPLEX || type == +AuctionType::RLPS ||
+      type == +AuctionType::MATCHING || type == +AuctionType::BERTSEKAS)
+    return false;
+  return true;
+}
+
+unsigned long deriveSeed(unsigned long seed, unsigned long stream) {
+  // SplitMix64 finalizer applied to the seed advanced by stream + 1 steps
+  uint64_t z = seed + (stream + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
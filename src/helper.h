@@ -42,7 +42,10 @@ BETTER_ENUM(AuctionType, int,
   CASANOVA,
   CASANOVAS,
   CPLEX,
-  RLPS
+  RLPS,
+  MATCHING,
+  BERTSEKAS,
+  SAPT
 )
 
 BETTER_ENUM(RunMode, int,
@@ -52,6 +55,16 @@ BETTER_ENUM(RunMode, int,
   RANDOM
 )
 
+BETTER_ENUM(OutputFormat, int,
+  CSV = 0,
+  JSONL
+)
+
+BETTER_ENUM(PricingMode, int,
+  K = 0,
+  VCG
+)
+
 constexpr const char* describe_algorithms(AuctionType type) {
   switch (type) {
     case AuctionType::GREEDY1: return "greedy algorihm";
@@ -68,6 +81,9 @@ constexpr const char* describe_algorithms(AuctionType type) {
     case AuctionType::CASANOVAS: return "Casanova algorithm (stochastic local search) with focus on sellers";
     case AuctionType::CPLEX: return "optimal algorithm using CPLEX library to solve MILP";
     case AuctionType::RLPS: return "heuristic based on relaxed linear program (requires CPLEX library)";
+    case AuctionType::MATCHING: return "optimal algorithm based on maximum-weight bipartite matching";
+    case AuctionType::BERTSEKAS: return "auction algorithm of Bertsekas with epsilon-scaling and parallel bidding";
+    case AuctionType::SAPT: return "simulated annealing with parallel tempering (replica exchange)";
     default: return "invalid auction type";
   }
 }
@@ -75,7 +91,7 @@ constexpr const char* describe_algorithms(AuctionType type) {
 constexpr const char* describe_run_modes(RunMode mode) {
   switch (mode) {
     case RunMode::ALL: return "run all algorithms";
-    case RunMode::HEURISTICS: return "run all heuristic algorithms (exclude CPLEX and RLPS from all)";
+    case RunMode::HEURISTICS: return "run all heuristic algorithms (exclude CPLEX, RLPS, MATCHING and BERTSEKAS from all)";
     case RunMode::SAMPLES: return "run all heuristic algorithms on instance and samples";
     case RunMode::RANDOM: return "run all stochastic algorithms";
     default: return "invalid mode";
@@ -89,7 +105,15 @@ typedef struct _InputParams_ {
   better_enums::optional<RunMode> mode;
   better_enums::optional<AuctionType> algo;
   std::string outfile;
+  better_enums::optional<OutputFormat> format;  // format of the stats rows
+  better_enums::optional<PricingMode> pricing;  // prices of the winners
   std::vector<std::string> infiles;
+  double epsilon;  // relative accuracy of the BERTSEKAS algorithm
+  unsigned int threads;  // number of algorithm runs executed concurrently
+  unsigned int algo_threads;  // threads of one algorithm run, with threads 1
+  unsigned long seed;    // master seed of the stochastic algorithms
+  unsigned int prefetch;  // number of instances loaded ahead
+  unsigned long prefetch_memory;  // memory cap of these instances in MB
 } InputParams;
 
 typedef struct _Neighbor_ {
@@ -114,4 +138,10 @@ boost::optional<InputParams> parse(int argc, char* argv[]);
 // whether an algorihtm is stochastic => will be run multiple times
 bool isStochastic(AuctionType type);
 
+// derives independent seeds (e.g. one per run) from a master seed
+unsigned long deriveSeed(unsigned long seed, unsigned long stream);
+
+// whether an algorithm is a heuristic => will be run in HEURISTICS mode
+bool isHeuristic(AuctionType type);
+
 #endif  // SRC_HELPER_H_
@@ -15,35 +15,261 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // --------------------------------------------------------------------------
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
 
 #include "src/instance.h"
+#include "src/ordered_compatibility.h"
+#include "src/yaml_instance_reader.h"
+
+namespace {
+
+// Binary instance file, in native byte order. The header is followed by the
+// values of the bids and asks (doubles), then by their quantities as rows
+// padded with zeros to the stride (unsigned ints). Each section starts at a
+// multiple of 64 bytes, so the rows are used in place once mapped.
+const char binary_magic[8] = {'C', 'A', 'I', 'N', 'S', 'T', 'B', 'N'};
+const uint32_t binary_version = 1;
+
+struct BinaryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t l;       // number of resources
+  uint64_t n;       // number of bids
+  uint64_t m;       // number of asks
+  uint32_t stride;  // padded row length
+  uint32_t reserved;
+  uint64_t bid_values, ask_values, bid_rows, ask_rows;  // section offsets
+};
+
+inline uint64_t align64(uint64_t offset) { return (offset + 63) / 64 * 64; }
+
+BinaryHeader binaryLayout(uint64_t n, uint64_t m, uint32_t l) {
+  BinaryHeader h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, binary_magic, sizeof(binary_magic));
+  h.version = binary_version;
+  h.l = l;
+  h.n = n;
+  h.m = m;
+  h.stride = paddedLength(l);
+  h.bid_values = align64(sizeof(BinaryHeader));
+  h.ask_values = align64(h.bid_values + n * sizeof(double));
+  h.bid_rows = align64(h.ask_values + m * sizeof(double));
+  h.ask_rows = align64(h.bid_rows + n * h.stride * sizeof(unsigned int));
+  return h;
+}
+
+// @return the read-only mapping of a whole file, unmapped with the last copy
+std::shared_ptr<const char> mapFile(std::string filename, uint64_t &size) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("bad file: " + filename);
+  struct stat st;
+  if (fstat(fd, &st) < 0 || st.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("bad file: " + filename);
+  }
+  size = st.st_size;
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) throw std::runtime_error("bad file: " + filename);
+  return std::shared_ptr<const char>(
+      static_cast<const char *>(data),
+      [size](const char *p) { munmap(const_cast<char *>(p), size); });
+}
+
+// Values are copied, rows point into the mapping and keep it alive.
+BidSet mappedBidSet(std::shared_ptr<const char> file, uint64_t values,
+                    uint64_t rows, uint64_t n, uint32_t l) {
+  const double *v = reinterpret_cast<const double *>(file.get() + values);
+  std::shared_ptr<const unsigned int> r_q(
+      file, reinterpret_cast<const unsigned int *>(file.get() + rows));
+  return BidSet(std::vector<double>(v, v + n), r_q, l);
+}
+
+}  // namespace
 
 Instance::Instance(const BidSet &_bids, const BidSet &_asks)
-    : bids(_bids), asks(_asks) {}
+    : bids(_bids), asks(_asks) {
+  computeAux();
+}
 
-Instance::Instance(const Instance &copy) : bids(copy.bids), asks(copy.asks) {}
+Instance::Instance(const Instance &copy)
+    : bids(copy.bids),
+      asks(copy.asks),
+      compatibility(copy.compatibility),
+      bids_aux(copy.bids_aux),
+      asks_aux(copy.asks_aux) {}
 
 Instance::Instance(std::string filename) {
-  YAML::Node inst = YAML::LoadFile(filename);
-  // std::cout << inst["params"] << std::endl;
-  bids = BidSet::fromYAML(inst["bids"]);
-  asks = BidSet::fromYAML(inst["asks"]);
-  assert(bids.L() == asks.L());
+  if (isBinaryFile(filename)) {
+    readBinary(filename);
+  } else {
+    // the first instance of a YAML file
+    YamlInstanceReader reader(filename);
+    if (!reader.next(bids, asks))
+      throw std::invalid_argument("no instance in " + filename);
+  }
+  computeAux();
 }
 
-Instance Instance::sample(double sampling_ratio) {
-  return Instance(bids.sample(sampling_ratio), asks.sample(sampling_ratio));
+void Instance::computeAux() {
+  bids_aux = std::make_shared<BidSetAux>(bids);
+  asks_aux = std::make_shared<BidSetAux>(asks);
 }
 
-bool Instance::canAllocate(int bidder, int seller) {
+void Instance::readAll(std::string filename,
+                       std::function<void(std::shared_ptr<Instance>)> handle) {
+  if (isBinaryFile(filename)) {
+    handle(std::make_shared<Instance>(filename));
+    return;
+  }
+  YamlInstanceReader reader(filename);
+  BidSet bids, asks;
+  while (reader.next(bids, asks))
+    handle(std::make_shared<Instance>(bids, asks));
+}
+
+bool Instance::isBinaryFile(std::string filename) {
+  char magic[sizeof(binary_magic)];
+  std::ifstream in(filename, std::ios::binary);
+  return in.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, binary_magic, sizeof(magic)) == 0;
+}
+
+void Instance::readBinary(std::string filename) {
+  uint64_t size;
+  auto file = mapFile(filename, size);
+  if (size < sizeof(BinaryHeader))
+    throw std::runtime_error("truncated binary instance: " + filename);
+  BinaryHeader h;
+  std::memcpy(&h, file.get(), sizeof(h));
+  if (h.version != binary_version)
+    throw std::runtime_error("unsupported binary instance version " +
+                             std::to_string(h.version) + ": " + filename);
+  BinaryHeader expected = binaryLayout(h.n, h.m, h.l);
+  if (std::memcmp(&h, &expected, sizeof(h)) != 0 ||
+      size < h.ask_rows + h.m * h.stride * sizeof(unsigned int))
+    throw std::runtime_error("corrupt binary instance: " + filename);
+
+  bids = mappedBidSet(file, h.bid_values, h.bid_rows, h.n, h.l);
+  asks = mappedBidSet(file, h.ask_values, h.ask_rows, h.m, h.l);
+}
+
+void Instance::writeBinary(std::string filename) const {
+  BinaryHeader h = binaryLayout(bids.N(), asks.N(), bids.L());
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out) throw std::runtime_error("cannot open output file " + filename);
+
+  // pads with zeros up to the next section
+  auto seek = [&out](uint64_t offset) {
+    static const char zeros[64] = {};
+    out.write(zeros, offset - out.tellp());
+  };
+  out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+  seek(h.bid_values);
+  out.write(reinterpret_cast<const char *>(bids.V().data()),
+            bids.N() * sizeof(double));
+  seek(h.ask_values);
+  out.write(reinterpret_cast<const char *>(asks.V().data()),
+            asks.N() * sizeof(double));
+  seek(h.bid_rows);
+  out.write(reinterpret_cast<const char *>(bids.row(0)),
+            (uint64_t)bids.N() * h.stride * sizeof(unsigned int));
+  seek(h.ask_rows);
+  out.write(reinterpret_cast<const char *>(asks.row(0)),
+            (uint64_t)asks.N() * h.stride * sizeof(unsigned int));
+  if (!out) throw std::runtime_error("cannot write output file " + filename);
+}
+
+Instance Instance::sample(double sampling_ratio) const {
+  Instance probe(*this);
+  probe.bids = bids.sample(sampling_ratio);
+  probe.asks = asks.sample(sampling_ratio);
+  probe.bids_aux = std::make_shared<BidSetAux>(*bids_aux, probe.bids.N());
+  probe.asks_aux = std::make_shared<BidSetAux>(*asks_aux, probe.asks.N());
+  return probe;
+}
+
+void Instance::buildCompatibilityIndex() {
+  compatibility =
+      std::make_shared<CompatibilityIndex>(bids, asks, indexedLazily());
+}
+
+std::size_t Instance::memoryUsage() const {
+  std::size_t bytes = bids.memoryUsage() + asks.memoryUsage();
+  if (compatibility) bytes += compatibility->memoryUsage();
+  std::lock_guard<std::mutex> lock(ordered.mutex);
+  for (auto &entry : ordered.entries)
+    bytes += entry.first.second.size() * sizeof(int) +
+             entry.second->memoryUsage();
+  return bytes;
+}
+
+std::shared_ptr<const OrderedCompatibility> Instance::orderedCompatibility(
+    bool rows_are_bids, const std::vector<int> &order) const {
+  std::lock_guard<std::mutex> lock(ordered.mutex);
+  auto &entry = ordered.entries[std::make_pair(rows_are_bids, order)];
+  if (!entry)
+    entry = std::make_shared<OrderedCompatibility>(*this, rows_are_bids, order);
+  return entry;
+}
+
+void Instance::buildOrderedCompatibilities() const {
+  // sorted like the algorithms sort their indices, so that they find them
+  std::vector<int> asks_sorted(asks.N()), bids_sorted(bids.N());
+  std::iota(asks_sorted.begin(), asks_sorted.end(), 0);
+  std::iota(bids_sorted.begin(), bids_sorted.end(), 0);
+  std::sort(asks_sorted.begin(), asks_sorted.end(),
+            [&](unsigned int i, unsigned int j) -> bool {
+              return asks_aux->getDensity()[i] < asks_aux->getDensity()[j];
+            });
+  std::sort(bids_sorted.begin(), bids_sorted.end(),
+            [&](unsigned int i, unsigned int j) -> bool {
+              return bids_aux->getDensity()[i] > bids_aux->getDensity()[j];
+            });
+  orderedCompatibility(true, asks_sorted);
+  orderedCompatibility(false, bids_sorted);
+}
+
+// same as canAllocate, without using the compatibility index
+bool Instance::checkAllocate(int bidder, int seller) const {
   // no allocation possible if bid value is less than the asked value
   if (bids.V()[bidder] < asks.V()[seller]) return false;
 
-  // no allocation possible if requested quantities are not at least matched
-  for (unsigned int k = 0; k < L(); ++k)
-    if (bids.Q()(bidder, k) > asks.Q()(seller, k)) return false;
+  // no allocation possible if requested quantities are not at least matched;
+  // otherwise all requirements are matched => bidder and seller _can_ trade
+  return dominates(asks.row(seller), bids.row(bidder), bids.S());
+}
 
-  // all requirements are matched => bidder and seller _can_ trade
-  return true;
-}
\ No newline at end of file
+std::vector<std::vector<int>> Instance::computeCompatibleAsks() const {
+  std::vector<std::vector<int>> compatible(bids.N());
+  if (compatibility) {
+    // enumerate the set bits of each row; the index of a sample also holds
+    // the asks beyond it
+    unsigned int words = (asks.N() + 63) / 64;
+    for (unsigned int i = 0; i < bids.N(); ++i) {
+      const uint64_t *row = compatibility->row(i);
+      for (unsigned int w = 0; w < words; ++w) {
+        uint64_t word = row[w];
+        if (64 * (w + 1) > asks.N()) word &= ~(~(uint64_t)0 << (asks.N() % 64));
+        for (; word; word &= word - 1)
+          compatible[i].push_back(64 * w + __builtin_ctzll(word));
+      }
+    }
+    return compatible;
+  }
+  for (unsigned int i = 0; i < bids.N(); ++i)
+    for (unsigned int j = 0; j < asks.N(); ++j)
+      if (canAllocate(i, j)) compatible[i].push_back(j);
+  return compatible;
+}
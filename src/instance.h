@@ -18,12 +18,47 @@
 #ifndef SRC_INSTANCE_H_
 #define SRC_INSTANCE_H_
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "src/bid_set.h"
+#include "src/bid_set_aux.h"
+#include "src/compatibility_index.h"
+
+class OrderedCompatibility;
 
 class Instance {
  protected:
   BidSet bids;
   BidSet asks;
+  // optional, shared between copies of the instance
+  std::shared_ptr<CompatibilityIndex> compatibility;
+  // densities and average prices with uniform relevance factors; these only
+  // depend on the bid (or ask) itself, so samples use a prefix of them
+  std::shared_ptr<const BidSetAux> bids_aux;
+  std::shared_ptr<const BidSetAux> asks_aux;
+
+  // ordered compatibilities built so far, by side of the rows and order;
+  // copies and samples of the instance start with an empty cache
+  struct OrderedCache {
+    OrderedCache() {}
+    OrderedCache(const OrderedCache &) {}
+    OrderedCache &operator=(const OrderedCache &) { return *this; }
+    std::mutex mutex;
+    std::map<std::pair<bool, std::vector<int>>,
+             std::shared_ptr<const OrderedCompatibility>>
+        entries;
+  };
+  mutable OrderedCache ordered;
+
+  void computeAux();
+
+  void readBinary(std::string filename);
 
  public:
   Instance(const BidSet &_bids, const BidSet &_asks);  // generic constructor
@@ -31,13 +66,67 @@ class Instance {
   Instance(std::string filename);  // creates instance from input file
   ~Instance(){};
 
-  Instance sample(double sampling_ratio);
+  // Input files are YAML, or binary files written by writeBinary. Binary
+  // files are mapped into memory, and their quantities are used in place.
+  static bool isBinaryFile(std::string filename);
+  // Calls handle with each instance of a file, in order: one per document of
+  // a YAML file, or the instance of a binary file. The file is read one
+  // instance at a time.
+  static void readAll(std::string filename,
+                      std::function<void(std::shared_ptr<Instance>)> handle);
+  void writeBinary(std::string filename) const;
 
-  bool canAllocate(int bidder, int seller);
+  // The first bids and asks of the instance, sharing its quantities and
+  // derived data; the compatibility index of the instance, if built, also
+  // answers for the sample.
+  Instance sample(double sampling_ratio) const;
 
-  inline unsigned int L() { return bids.L(); }
-  const BidSet &getBids() { return bids; }
-  const BidSet &getAsks() { return asks; }
+  // instances with more pairs are indexed lazily, row by row
+  static constexpr unsigned long max_eager_pairs = 1ul << 30;
+  inline bool indexedLazily() const {
+    return (unsigned long)bids.N() * asks.N() > max_eager_pairs;
+  }
+  // precomputes canAllocate for all pairs, then answered in O(1)
+  void buildCompatibilityIndex();
+  inline bool hasCompatibilityIndex() const { return bool(compatibility); }
+
+  inline bool canAllocate(int bidder, int seller) const {
+    if (compatibility) return compatibility->get(bidder, seller);
+    return checkAllocate(bidder, seller);
+  }
+  bool checkAllocate(int bidder, int seller) const;
+  // bit row of the asks compatible with a bid, as in CompatibilityIndex::row;
+  // nullptr without a compatibility index
+  inline const uint64_t *compatibleRow(int bidder) const {
+    if (compatibility) return compatibility->row(bidder);
+    return nullptr;
+  }
+  // lists the asks that can be allocated to each bid (compatible pairs)
+  std::vector<std::vector<int>> computeCompatibleAsks() const;
+  // compatible pairs over one side in a fixed order, see
+  // OrderedCompatibility; built once per order and shared by all algorithms
+  // run on the instance
+  // @param rows_are_bids whether the rows are the bids or the asks
+  // @param order the order of the other side
+  std::shared_ptr<const OrderedCompatibility> orderedCompatibility(
+      bool rows_are_bids, const std::vector<int> &order) const;
+  // builds the ordered compatibilities of the heuristic algorithms ahead of
+  // their runs: the asks ascending and the bids descending by density
+  void buildOrderedCompatibilities() const;
+
+  // approximate bytes held by the instance, its compatibility index and its
+  // ordered compatibilities
+  std::size_t memoryUsage() const;
+
+  inline unsigned int L() const { return bids.L(); }
+  const BidSet &getBids() const { return bids; }
+  const BidSet &getAsks() const { return asks; }
+  const BidSetAux &getBidsAux() const { return *bids_aux; }
+  const BidSetAux &getAsksAux() const { return *asks_aux; }
 };
 
+// shared handle to an instance that is no longer modified, e.g. by the
+// algorithms of a portfolio; all const methods are thread-safe
+using InstancePtr = std::shared_ptr<const Instance>;
+
 #endif  // SRC_INSTANCE_H_
\ No newline at end of file
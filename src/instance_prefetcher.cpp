@@ -0,0 +1,119 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/instance_prefetcher.h"
+
+#include <algorithm>
+
+namespace {
+
+// thrown into a loader to abandon its file when the prefetcher is stopped
+struct Cancelled {};
+
+}  // namespace
+
+InstancePrefetcher::InstancePrefetcher(
+    const std::vector<std::string> &infiles_, Loader load_,
+    unsigned int depth_, std::size_t max_bytes_)
+    : infiles(infiles_),
+      load(load_),
+      depth(std::max(1u, depth_)),
+      max_bytes(max_bytes_),
+      slots(infiles_.size()) {
+  unsigned int num_loaders = std::min<std::size_t>(depth, infiles.size());
+  for (unsigned int t = 0; t < num_loaders; ++t)
+    loaders.push_back(std::thread(&InstancePrefetcher::work, this));
+}
+
+InstancePrefetcher::~InstancePrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  room.notify_all();
+  for (auto &loader : loaders) loader.join();
+}
+
+bool InstancePrefetcher::next(InstancePtr &instance, std::string &name) {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (head < slots.size()) {
+    Slot &slot = slots[head];
+    if (!slot.entries.empty()) {
+      Entry &entry = slot.entries.front();
+      instance = entry.instance;
+      name = entry.name;
+      --ahead;
+      ahead_bytes -= entry.bytes;
+      slot.entries.pop_front();
+      room.notify_all();
+      return true;
+    }
+    if (slot.done) {
+      ++head;
+      room.notify_all();
+      if (slot.error) std::rethrow_exception(slot.error);
+      continue;
+    }
+    ready.wait(lock);
+  }
+  return false;
+}
+
+// Takes the next file to load until all files are taken.
+void InstancePrefetcher::work() {
+  while (true) {
+    unsigned int file;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stop || next_file >= infiles.size()) return;
+      file = next_file++;
+    }
+    std::exception_ptr error;
+    try {
+      load(infiles[file], [this, file](InstancePtr instance, std::string name) {
+        put(file, instance, name);
+      });
+    } catch (Cancelled &) {
+      return;
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    slots[file].error = error;
+    slots[file].done = true;
+    ready.notify_all();
+  }
+}
+
+// Waits until there is room for an instance, then queues it.
+void InstancePrefetcher::put(unsigned int file, InstancePtr instance,
+                             std::string name) {
+  std::size_t bytes = instance->memoryUsage();
+  std::unique_lock<std::mutex> lock(mutex);
+  room.wait(lock, [&]() {
+    // a single instance above the memory cap is let through alone, and the
+    // consumer never waits for its current file behind the limits
+    return stop || ahead == 0 ||
+           (file == head && slots[head].entries.empty()) ||
+           (ahead < depth && ahead_bytes + bytes <= max_bytes);
+  });
+  if (stop) throw Cancelled();
+  slots[file].entries.push_back(Entry{instance, name, bytes});
+  ++ahead;
+  ahead_bytes += bytes;
+  ready.notify_all();
+}
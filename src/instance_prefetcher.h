@@ -0,0 +1,91 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_INSTANCE_PREFETCHER_H_
+#define SRC_INSTANCE_PREFETCHER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/instance.h"
+
+// Loads the instances of upcoming files on background threads while the
+// current instance is solved. At most depth instances, and at most max_bytes
+// of them, are held ahead of the consumer; each loader thread reads its own
+// file. The file the consumer waits for may always queue one instance, so
+// the limits never block the pipeline.
+class InstancePrefetcher {
+ public:
+  // reads the instances of a file and passes each one, with its name, on
+  typedef std::function<void(
+      std::string infile,
+      std::function<void(InstancePtr instance, std::string name)> handle)>
+      Loader;
+
+  // @param depth maximum number of instances loaded ahead, also the maximum
+  // number of loader threads
+  // @param max_bytes maximum memory of the instances loaded ahead
+  InstancePrefetcher(const std::vector<std::string> &infiles, Loader load,
+                     unsigned int depth, std::size_t max_bytes);
+  ~InstancePrefetcher();  // stops loading
+
+  // Returns the instances in the order of the files and of their documents,
+  // and rethrows the error of a file that could not be read.
+  // @return false once all instances were returned
+  bool next(InstancePtr &instance, std::string &name);
+
+ private:
+  struct Entry {
+    InstancePtr instance;
+    std::string name;
+    std::size_t bytes;
+  };
+  // instances of one file
+  struct Slot {
+    std::deque<Entry> entries;
+    bool done = false;
+    std::exception_ptr error;
+  };
+
+  void work();
+  void put(unsigned int file, InstancePtr instance, std::string name);
+
+  std::vector<std::string> infiles;
+  Loader load;
+  unsigned int depth;
+  std::size_t max_bytes;
+
+  std::vector<Slot> slots;    // by file
+  unsigned int next_file = 0;  // next file to be loaded
+  unsigned int head = 0;       // file the consumer reads from
+  unsigned int ahead = 0;      // instances loaded, not yet returned
+  std::size_t ahead_bytes = 0;
+  bool stop = false;
+
+  std::mutex mutex;
+  std::condition_variable room;   // signaled when instances are returned
+  std::condition_variable ready;  // signaled when instances are loaded
+  std::vector<std::thread> loaders;
+};
+
+#endif  // SRC_INSTANCE_PREFETCHER_H_
@@ -15,11 +15,47 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // --------------------------------------------------------------------------
 
+#ifdef _MPI
+#include <boost/mpi.hpp>
+#endif
+
+#include <iostream>
+#include <string>
+
 #include "src/helper.h"
+#include "src/instance.h"
 #include "src/runner.h"
 
+// converts a YAML instance file into a binary instance file
+int convert(int argc, char *argv[]) {
+  if (argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " convert INFILE OUTFILE" << std::endl;
+    return 1;
+  }
+  try {
+    Instance(argv[2]).writeBinary(argv[3]);
+  } catch (std::exception &e) {
+    std::cerr << argv[0] << ": " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "convert") return convert(argc, argv);
+#ifdef _MPI
+  boost::mpi::environment env(argc, argv);
+  boost::mpi::communicator world;
+#endif
   auto params = parse(argc, argv);
-  if (params) Runner::run(*params);
+  if (!params) return 0;
+#ifdef _MPI
+  // started with mpirun on several ranks
+  if (world.size() > 1) {
+    Runner::runDistributed(*params);
+    return 0;
+  }
+#endif
+  Runner::run(*params);
   return 0;
 }
@@ -0,0 +1,50 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/minimum_tree.h"
+
+#include <algorithm>
+#include <limits>
+
+MinimumTree::MinimumTree(unsigned int n_) : n(n_), leaves(1) {
+  while (leaves < n) leaves *= 2;
+  tree.assign(2 * leaves, std::numeric_limits<double>::infinity());
+}
+
+void MinimumTree::set(unsigned int p, double value) {
+  unsigned int k = leaves + p;
+  tree[k] = value;
+  for (k /= 2; k > 0; k /= 2) tree[k] = std::min(tree[2 * k], tree[2 * k + 1]);
+}
+
+unsigned int MinimumTree::firstBelow(unsigned int p, double bound) const {
+  if (p >= n) return n;
+  return std::min(n, firstBelow(1, 0, leaves, p, bound));
+}
+
+// Searches the node k, which covers the positions [lo, hi).
+unsigned int MinimumTree::firstBelow(unsigned int k, unsigned int lo,
+                                     unsigned int hi, unsigned int p,
+                                     double bound) const {
+  // the whole range is before p, or dominates the bound
+  if (hi <= p || tree[k] >= bound) return leaves;
+  if (hi - lo == 1) return lo;
+  unsigned int mid = (lo + hi) / 2;
+  unsigned int first = firstBelow(2 * k, lo, mid, p, bound);
+  if (first < leaves) return first;
+  return firstBelow(2 * k + 1, mid, hi, p, bound);
+}
@@ -0,0 +1,49 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_MINIMUM_TREE_H_
+#define SRC_MINIMUM_TREE_H_
+
+#include <vector>
+
+// Values at the positions 0, ..., n-1 of a fixed order, e.g. the value of
+// the bid matched to each ask, with the first position holding a value
+// below a bound found in O(log n): a segment tree keeps the minimum of
+// ranges of positions.
+class MinimumTree {
+ public:
+  MinimumTree() {}
+  explicit MinimumTree(unsigned int n);  // all values infinite
+
+  void set(unsigned int p, double value);
+
+  // @return the first position at or after p with a value below bound, or n
+  // if none
+  unsigned int firstBelow(unsigned int p, double bound) const;
+
+ private:
+  unsigned int firstBelow(unsigned int k, unsigned int lo, unsigned int hi,
+                          unsigned int p, double bound) const;
+
+  unsigned int n = 0;
+  unsigned int leaves = 0;  // power of 2, at least n
+  // tree[k], k from 1, is the minimum of its children 2k and 2k+1; the
+  // leaves start at tree[leaves]
+  std::vector<double> tree;
+};
+
+#endif  // SRC_MINIMUM_TREE_H_
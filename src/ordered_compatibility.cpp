@@ -0,0 +1,137 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/ordered_compatibility.h"
+
+OrderedCompatibility::OrderedCompatibility(const Instance &instance_,
+                                           bool rows_are_bids_,
+                                           const std::vector<int> &order_)
+    : instance(instance_),
+      rows_are_bids(rows_are_bids_),
+      lazy(instance_.indexedLazily()),
+      order(order_),
+      words((order_.size() + 63) / 64) {
+  unsigned int n = instance.getBids().N();
+  unsigned int m = instance.getAsks().N();
+  position.resize(rows_are_bids ? m : n);
+  for (unsigned int p = 0; p < order.size(); ++p) position[order[p]] = p;
+  if (lazy) {
+    lazy_rows.resize(rows_are_bids ? n : m);
+    row_once.reset(new std::once_flag[lazy_rows.size()]);
+    return;
+  }
+
+  rows.assign((unsigned long)(rows_are_bids ? n : m) * words, 0);
+  auto set = [&](unsigned int i, unsigned int j) {
+    unsigned int x = rows_are_bids ? i : j;
+    unsigned int p = position[rows_are_bids ? j : i];
+    rows[(unsigned long)x * words + p / 64] |= 1ull << (p % 64);
+  };
+
+  if (!instance.hasCompatibilityIndex()) {
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < m; ++j)
+        if (instance.canAllocate(i, j)) set(i, j);
+    return;
+  }
+  // enumerate the set bits of the index; the index of a sample also holds
+  // the asks beyond it
+  unsigned int index_words = (m + 63) / 64;
+  for (unsigned int i = 0; i < n; ++i) {
+    const uint64_t *r = instance.compatibleRow(i);
+    for (unsigned int w = 0; w < index_words; ++w) {
+      uint64_t word = r[w];
+      if (64 * (w + 1) > m) word &= ~(~0ull << (m % 64));
+      for (; word; word &= word - 1) set(i, 64 * w + __builtin_ctzll(word));
+    }
+  }
+}
+
+// Builds the row of x without forcing the other rows of a lazy index: a bid
+// row is built from the index row of the bid, an ask row by checking each
+// bid.
+void OrderedCompatibility::computeRow(int x) const {
+  std::vector<uint64_t> &r = lazy_rows[x];
+  r.assign(words, 0);
+  auto set = [&](unsigned int y) {
+    unsigned int p = position[y];
+    r[p / 64] |= 1ull << (p % 64);
+  };
+  unsigned int m = instance.getAsks().N();
+  const uint64_t *index_row =
+      rows_are_bids ? instance.compatibleRow(x) : nullptr;
+  if (index_row) {
+    for (unsigned int w = 0; w < (m + 63) / 64; ++w) {
+      uint64_t word = index_row[w];
+      if (64 * (w + 1) > m) word &= ~(~0ull << (m % 64));
+      for (; word; word &= word - 1) set(64 * w + __builtin_ctzll(word));
+    }
+  } else if (rows_are_bids) {
+    for (unsigned int j = 0; j < m; ++j)
+      if (instance.checkAllocate(x, j)) set(j);
+  } else {
+    for (unsigned int i = 0; i < instance.getBids().N(); ++i)
+      if (instance.checkAllocate(i, x)) set(i);
+  }
+  ++rows_built;
+}
+
+unsigned int OrderedCompatibility::next(int x, unsigned int p) const {
+  unsigned int w = p / 64;
+  if (w >= words) return size();
+  const uint64_t *r = row(x);
+  uint64_t word = r[w] & (~0ull << (p % 64));
+  while (!word) {
+    if (++w >= words) return size();
+    word = r[w];
+  }
+  return w * 64 + __builtin_ctzll(word);
+}
+
+unsigned int OrderedCompatibility::first(
+    int x, const std::vector<uint64_t> &subset) const {
+  const uint64_t *r = row(x);
+  for (unsigned int w = 0; w < words; ++w)
+    if (uint64_t word = r[w] & subset[w]) return w * 64 + __builtin_ctzll(word);
+  return size();
+}
+
+unsigned int OrderedCompatibility::next(
+    int x, unsigned int p, const std::vector<uint64_t> &subset) const {
+  unsigned int w = p / 64;
+  if (w >= words) return size();
+  const uint64_t *r = row(x);
+  uint64_t word = r[w] & subset[w] & (~0ull << (p % 64));
+  while (!word) {
+    if (++w >= words) return size();
+    word = r[w] & subset[w];
+  }
+  return w * 64 + __builtin_ctzll(word);
+}
+
+std::size_t OrderedCompatibility::memoryUsage() const {
+  return (order.size() + position.size()) * sizeof(int) +
+         (rows.size() + rows_built * words) * sizeof(uint64_t) +
+         lazy_rows.size() * (sizeof(std::vector<uint64_t>) +
+                             sizeof(std::once_flag));
+}
+
+std::vector<uint64_t> OrderedCompatibility::all() const {
+  std::vector<uint64_t> subset(words, ~0ull);
+  if (size() % 64) subset.back() = ~(~0ull << (size() % 64));
+  return subset;
+}
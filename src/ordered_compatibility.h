@@ -0,0 +1,92 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_ORDERED_COMPATIBILITY_H_
+#define SRC_ORDERED_COMPATIBILITY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "src/instance.h"
+
+// Compatible pairs of an instance as one bit row per element of one side
+// (the bids, or the asks), over the elements of the other side in a fixed
+// order, e.g. by density. The first compatible element after a position, or
+// in a subset of the other side, is then found by scanning words. The rows
+// are built from the compatibility index when the instance has one; on
+// instances indexed lazily, a row is built the first time it is queried, and
+// rows can be queried concurrently. Algorithms share them through
+// Instance::orderedCompatibility.
+class OrderedCompatibility {
+ public:
+  // @param rows_are_bids whether the rows are the bids or the asks
+  // @param order the order of the other side
+  OrderedCompatibility(const Instance &instance, bool rows_are_bids,
+                       const std::vector<int> &order);
+
+  inline unsigned int size() const { return order.size(); }
+  inline unsigned int W() const { return words; }  // 64-bit words per row
+  inline int at(unsigned int p) const { return order[p]; }
+  inline unsigned int positionOf(int y) const { return position[y]; }
+
+  // position of the first element compatible with x at or after position p,
+  // or size() if none
+  unsigned int next(int x, unsigned int p) const;
+  // position of the first element compatible with x in a subset, given as
+  // a bit row over the positions, or size() if none
+  unsigned int first(int x, const std::vector<uint64_t> &subset) const;
+  // same, at or after position p
+  unsigned int next(int x, unsigned int p,
+                    const std::vector<uint64_t> &subset) const;
+
+  // subset of all elements of the other side
+  std::vector<uint64_t> all() const;
+  // bytes held by the rows, with the lazy rows built so far
+  std::size_t memoryUsage() const;
+
+  // adds element y to a subset, or removes it
+  inline void toggle(std::vector<uint64_t> &subset, int y) const {
+    subset[position[y] / 64] ^= 1ull << (position[y] % 64);
+  }
+
+ private:
+  inline const uint64_t *row(int x) const {
+    if (!lazy) return &rows[(unsigned long)x * words];
+    std::call_once(row_once[x], [this, x]() { computeRow(x); });
+    return lazy_rows[x].data();
+  }
+  void computeRow(int x) const;
+
+  const Instance &instance;
+  const bool rows_are_bids;
+  const bool lazy;
+  std::vector<int> order;              // element at each position
+  std::vector<unsigned int> position;  // position of each element
+  unsigned int words = 0;
+  // bit p % 64 of word x * words + p / 64 tells if x and the element at
+  // position p are compatible
+  std::vector<uint64_t> rows;
+  // lazy variant: rows built so far, as in CompatibilityIndex
+  mutable std::vector<std::vector<uint64_t>> lazy_rows;
+  std::unique_ptr<std::once_flag[]> row_once;
+  mutable std::atomic<std::size_t> rows_built{0};
+};
+
+#endif  // SRC_ORDERED_COMPATIBILITY_H_
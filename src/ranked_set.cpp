@@ -0,0 +1,61 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/ranked_set.h"
+
+RankedSet::RankedSet(unsigned int n_)
+    : n(n_), top(1), tree(n_ + 1, 0), member(n_, 0) {
+  while (2 * top <= n) top *= 2;
+}
+
+void RankedSet::fill() {
+  // node k covers lowbit(k) positions, all members
+  for (unsigned int k = 1; k <= n; ++k) tree[k] = k & -k;
+  member.assign(n, 1);
+  count = n;
+}
+
+void RankedSet::insert(unsigned int p) {
+  if (member[p]) return;
+  member[p] = 1;
+  ++count;
+  add(p, 1);
+}
+
+void RankedSet::erase(unsigned int p) {
+  if (!member[p]) return;
+  member[p] = 0;
+  --count;
+  add(p, -1);
+}
+
+void RankedSet::add(unsigned int p, int delta) {
+  for (unsigned int k = p + 1; k <= n; k += k & -k) tree[k] += delta;
+}
+
+// Descends the implicit tree: skips the ranges with at most r members.
+unsigned int RankedSet::select(unsigned int r) const {
+  unsigned int k = 0;
+  for (unsigned int step = top; step > 0; step /= 2) {
+    if (k + step <= n && tree[k + step] <= r) {
+      k += step;
+      r -= tree[k];
+    }
+  }
+  // positions 0..k-1 hold r members, and position k is a member
+  return k;
+}
@@ -0,0 +1,50 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_RANKED_SET_H_
+#define SRC_RANKED_SET_H_
+
+#include <vector>
+
+// Subset of the positions 0, ..., n-1 of a fixed order, e.g. the bids sorted
+// by score. Insertion, deletion and the member of a given rank take
+// O(log n): a Fenwick tree counts the members of ranges of positions.
+class RankedSet {
+ public:
+  RankedSet() {}
+  explicit RankedSet(unsigned int n);  // empty
+
+  void fill();  // all positions become members
+  void insert(unsigned int p);
+  void erase(unsigned int p);
+  inline bool contains(unsigned int p) const { return member[p]; }
+  inline unsigned int size() const { return count; }
+
+  // @return the position of the member of rank r (from 0), r < size()
+  unsigned int select(unsigned int r) const;
+
+ private:
+  void add(unsigned int p, int delta);
+
+  unsigned int n = 0;
+  unsigned int count = 0;
+  unsigned int top = 0;  // largest power of 2 not above n
+  std::vector<unsigned int> tree;  // tree[k], k from 1, counts (k - lowbit, k]
+  std::vector<char> member;
+};
+
+#endif  // SRC_RANKED_SET_H_
@@ -17,106 +17,200 @@
 
 #include "src/runner.h"
 
-#include <boost/unordered_map.hpp>
-#include <fstream>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <string>
 
 #include "src/ca_factory.h"
+#include "src/instance_prefetcher.h"
+#include "src/thread_pool.h"
 
-void Runner::runAlgo(Instance instance, AuctionType type, std::string outfile,
-                     std::string infile, double sampling_ratio) {
-  try {
-    CA* ca = CAFactory::createAuction(instance, type);
-    if (!ca)
-      throw std::invalid_argument(
-          std::string("Something went wrong when creating auction of type ") +
-          type._to_string());
-    unsigned int nruns = 1;
-    if (isStochastic(type)) nruns = 10;
-    for (unsigned int run = 0; run < nruns; ++run) {
-      ca->run();
-      // ca->printResults(type._to_string());
-      auto stats = ca->getStats();
-      writeStats(stats, type, outfile, infile, sampling_ratio);
-    }
-    delete ca;
-  } catch (std::invalid_argument& e) {
-    std::cerr << "[WARNING] " << e.what() << std::endl;
-  } catch (std::exception& e) {
-    std::cerr << "[ERROR] " << e.what() << std::endl;
+// Algorithms to run on each instance file: the given algorithm, or those of
+// the given mode (HEURISTICS by default).
+// @return the tasks, in the order their stats are written
+std::vector<Runner::Task> Runner::tasksOf(const InputParams& params) {
+  std::vector<Task> tasks;
+  if (params.algo) {
+    tasks.push_back(Task{*params.algo, 1.0});
+    return tasks;
   }
-}
-
-void Runner::runMode(Instance instance, RunMode mode, std::string outfile,
-                     std::string infile) {
+  RunMode mode = RunMode::HEURISTICS;
+  if (params.mode) mode = *params.mode;
   switch (mode) {
     case RunMode::ALL:
-      for (auto type : AuctionType::_values())
-        Runner::runAlgo(instance, type, outfile, infile, 1.0);
+      for (auto type : AuctionType::_values()) tasks.push_back(Task{type, 1.0});
       break;
     case RunMode::HEURISTICS:
       for (auto type : AuctionType::_values())
-        if (type != +AuctionType::CPLEX && type != +AuctionType::RLPS)
-          Runner::runAlgo(instance, type, outfile, infile, 1.0);
+        if (isHeuristic(type)) tasks.push_back(Task{type, 1.0});
       break;
     case RunMode::SAMPLES:
       {
         double sampling_ratios[] = {0.05, 0.1,  0.15, 0.2,  0.25, 0.3,  0.35,
                                     0.4,  0.45, 0.5,  0.55, 0.6,  0.65, 0.7,
                                     0.75, 0.8,  0.85, 0.9,  0.95};
-        for (double sampling_ratio : sampling_ratios) {
-          Instance probe = instance.sample(sampling_ratio);
+        for (double sampling_ratio : sampling_ratios)
           for (auto type : AuctionType::_values())
-            if (type != +AuctionType::CPLEX && type != +AuctionType::RLPS)
-              Runner::runAlgo(probe, type, outfile, infile,
-                              sampling_ratio);
-        }
+            if (isHeuristic(type)) tasks.push_back(Task{type, sampling_ratio});
       }
       break;
     case RunMode::RANDOM:
       for (auto type : AuctionType::_values())
-        if (isStochastic(type))
-          Runner::runAlgo(instance, type, outfile, infile, 1.0);
+        if (isStochastic(type)) tasks.push_back(Task{type, 1.0});
       break;
   }
+  return tasks;
 }
 
-void Runner::run(InputParams params) {
-  // loop over instance files and write the stats for one instance all at once
-  for (auto infile : params.infiles) {
-    Instance instance(infile);
-    boost::unordered_map<std::string, Stats> stats;
+// Binds tasks to an instance; tasks with the same sampling ratio share one
+// sample of the instance, which is a view of its first bids and asks.
+std::vector<Runner::Job> Runner::jobsOf(InstancePtr instance,
+                                        const std::vector<Task>& tasks) {
+  std::map<double, InstancePtr> samples{{1.0, instance}};
+  std::vector<Job> jobs;
+  for (auto& task : tasks) {
+    auto& sample = samples[task.sampling_ratio];
+    // shares the compatibility index of the instance
+    if (!sample) {
+      sample =
+          std::make_shared<Instance>(instance->sample(task.sampling_ratio));
+      sample->buildOrderedCompatibilities();
+    }
+    jobs.push_back(Job{sample, task.type, task.sampling_ratio});
+  }
+  return jobs;
+}
+
+// Reads the instances of a file one after the other. The first instance is
+// named after the file, the k-th following one INFILE:k.
+void Runner::loadInstances(
+    std::string infile,
+    std::function<void(InstancePtr instance, std::string name)> handle) {
+  unsigned int document = 0;
+  Instance::readAll(infile, [&](std::shared_ptr<Instance> instance) {
+    // shared by all algorithms run on this instance, built before any run
+    // is timed
+    instance->buildCompatibilityIndex();
+    instance->buildOrderedCompatibilities();
+    std::string name = infile;
+    if (document > 0) name += ":" + std::to_string(document);
+    ++document;
+    handle(instance, name);
+  });
+}
+
+// Runs an algorithm on a fresh CA object. Stochastic algorithms are run 10
+// times, and each run gets its own seed derived from the master seed.
+// @param run the index of the run
+// @param num_threads threads the run may use, including the calling one
+// @return the stats of the run
+Stats Runner::solve(InstancePtr instance, AuctionType type,
+                    const InputParams& params, unsigned int run,
+                    unsigned int num_threads) {
+  std::unique_ptr<CA> ca(CAFactory::createAuction(instance, type,
+                                                  params.epsilon, num_threads));
+  if (!ca)
+    throw std::invalid_argument(
+        std::string("Something went wrong when creating auction of type ") +
+        type._to_string());
+  ca->setPricing(*params.pricing);
+  if (isStochastic(type)) {
+    unsigned long seed = deriveSeed(params.seed, type._to_integral());
+    ca->setSeed(deriveSeed(seed, run));
+  }
+  ca->run();
+  // ca->printResults(type._to_string());
+  return ca->getStats();
+}
+
+// @return the header line of the output, rows of samples have an additional
+// sampling ratio column
+std::string Runner::headerOf(const InputParams& params,
+                             const std::vector<Task>& tasks) {
+  bool sampled = false;
+  for (auto& task : tasks)
+    if (task.sampling_ratio != 1.0) sampled = true;
+  return StatsWriter::header(*params.format, sampled);
+}
 
-    if (params.algo) {  // when specified, run a single algorithm
-      runAlgo(instance, *params.algo, params.outfile, infile, 1.0);
-    } else if (params.mode) {  // when specified, run in given mode
-      runMode(instance, *params.mode, params.outfile, infile);
-    } else {  // defaults to HEURISTICS mode
-      runMode(instance, RunMode::HEURISTICS, params.outfile, infile);
+void Runner::runJobs(const std::vector<Job>& jobs, const InputParams& params,
+                     std::string infile, StatsWriter& writer) {
+  // with a single thread, each run is executed when its stats are written
+  std::unique_ptr<ThreadPool> pool;
+  if (params.threads > 1) pool.reset(new ThreadPool(params.threads));
+  // concurrent runs are single-threaded, so they do not oversubscribe cores
+  unsigned int num_threads = pool ? 1 : params.algo_threads;
+
+  // all runs are submitted at once, but their stats are written in the order
+  // of the jobs, as soon as all previous runs are written
+  std::vector<std::vector<std::future<Stats>>> results(jobs.size());
+  for (unsigned int k = 0; k < jobs.size(); ++k) {
+    unsigned int nruns = 1;
+    if (isStochastic(jobs[k].type)) nruns = 10;
+    for (unsigned int run = 0; run < nruns; ++run) {
+      auto job = jobs[k];
+      auto task = [&params, job, run, num_threads]() {
+        return solve(job.instance, job.type, params, run, num_threads);
+      };
+      if (pool)
+        results[k].push_back(pool->submit(task));
+      else
+        results[k].push_back(std::async(std::launch::deferred, task));
     }
   }
+
+  for (unsigned int k = 0; k < jobs.size(); ++k) {
+    auto result_of = [&](unsigned int run) { return results[k][run].get(); };
+    writeResult(collectResult(result_of, results[k].size(), jobs[k].type,
+                              infile, jobs[k].sampling_ratio, *params.format),
+                writer);
+  }
 }
 
-void Runner::writeStats(Stats stats, AuctionType type, std::string outfile,
-                        std::string infile, double sampling_ratio) {
-  // set output mode: standard out or file
-  std::ostream* osp = &std::cout;
-  std::ofstream fout;
-  if (outfile != "") {
-    fout.open(outfile, std::ios::app);
-    osp = &fout;
+void Runner::run(InputParams params) {
+  // loop over instance files, the output stays open for all of them
+  auto tasks = tasksOf(params);
+  StatsWriter writer(params.outfile, headerOf(params, tasks));
+  auto solveAll = [&](InstancePtr instance, std::string name) {
+    runJobs(jobsOf(instance, tasks), params, name, writer);
+  };
+  if (params.prefetch == 0) {
+    for (auto infile : params.infiles) loadInstances(infile, solveAll);
+    return;
   }
 
-  // write stats
-  if (sampling_ratio == 1.0)
-    *osp << infile << "," << type << stats << std::endl;
-  else
-    *osp << sampling_ratio << "," << infile << "," << type << stats
-         << std::endl;
+  // upcoming instances are loaded while the current one is solved
+  InstancePrefetcher prefetcher(params.infiles, loadInstances, params.prefetch,
+                                params.prefetch_memory << 20);
+  InstancePtr instance;
+  std::string name;
+  while (prefetcher.next(instance, name)) solveAll(instance, name);
+}
 
-  // close file
-  if (outfile != "") {
-    fout.close();
+// Formats the stats of the runs of an algorithm, in order, up to the first
+// run that fails and the reason it failed.
+// @param result_of returns the stats of a run, or throws
+// @param nruns the number of runs
+Runner::Result Runner::collectResult(
+    std::function<Stats(unsigned int)> result_of, unsigned int nruns,
+    AuctionType type, std::string infile, double sampling_ratio,
+    OutputFormat format) {
+  Result result;
+  try {
+    for (unsigned int run = 0; run < nruns; ++run)
+      result.rows += StatsWriter::formatRow(result_of(run), type, infile,
+                                            sampling_ratio, format);
+  } catch (std::invalid_argument& e) {
+    result.error = std::string("[WARNING] ") + e.what();
+  } catch (std::exception& e) {
+    result.error = std::string("[ERROR] ") + e.what();
   }
+  return result;
+}
+
+void Runner::writeResult(const Result& result, StatsWriter& writer) {
+  writer.write(result.rows);
+  if (result.error != "") std::cerr << result.error << std::endl;
 }
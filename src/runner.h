@@ -18,24 +18,69 @@
 #ifndef SRC_RUNNER_H_
 #define SRC_RUNNER_H_
 
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "src/helper.h"
 #include "src/instance.h"
 #include "src/stats.h"
+#include "src/stats_writer.h"
 
 class Runner {
  public:
   static void run(InputParams params);
+#ifdef _MPI
+  // Runs the same work as run on the ranks of an MPI job: rank 0 hands out
+  // (instance file, algorithm) work items to the other ranks and writes
+  // their stats. Defined in src/runner_mpi.cpp.
+  static void runDistributed(InputParams params);
+#endif
 
  private:
-  static void runAlgo(Instance instance, AuctionType type, std::string outfile,
-                      std::string infile, double sampling_ratio);
-  static void runMode(Instance instance, RunMode mode, std::string outfile,
-                      std::string infile);
-  static void writeStats(Stats stats, AuctionType type, std::string outfile,
-                         std::string infile, double sampling_ratio);
+  // an algorithm to run on an instance (sampling ratio 1), or on a sample
+  typedef struct _Task_ {
+    AuctionType type;
+    double sampling_ratio;
+  } Task;
+
+  // a task bound to the instance, or sample, it runs on
+  typedef struct _Job_ {
+    InstancePtr instance;
+    AuctionType type;
+    double sampling_ratio;
+  } Job;
+
+  // formatted stats rows of all runs of a job, or the reason it failed
+  typedef struct _Result_ {
+    std::string rows;
+    std::string error;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+      ar & rows & error;
+    }
+  } Result;
+
+  static std::vector<Task> tasksOf(const InputParams& params);
+  static std::vector<Job> jobsOf(InstancePtr instance,
+                                 const std::vector<Task>& tasks);
+  static void loadInstances(
+      std::string infile,
+      std::function<void(InstancePtr instance, std::string name)> handle);
+  static Stats solve(InstancePtr instance, AuctionType type,
+                     const InputParams& params, unsigned int run,
+                     unsigned int num_threads);
+  static std::string headerOf(const InputParams& params,
+                              const std::vector<Task>& tasks);
+  static void runJobs(const std::vector<Job>& jobs, const InputParams& params,
+                      std::string infile, StatsWriter& writer);
+  static Result collectResult(std::function<Stats(unsigned int)> result_of,
+                              unsigned int nruns, AuctionType type,
+                              std::string infile, double sampling_ratio,
+                              OutputFormat format);
+  static void writeResult(const Result& result, StatsWriter& writer);
 };
 
 #endif  // SRC_RUNNER_H_
\ No newline at end of file
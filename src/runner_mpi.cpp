@@ -0,0 +1,125 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include <boost/mpi.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/runner.h"
+
+namespace mpi = boost::mpi;
+
+namespace {
+
+// message tags
+const int WORK = 1;    // rank 0 -> worker: index of the next work item
+const int STOP = 2;    // rank 0 -> worker: no work left
+const int RESULT = 3;  // worker -> rank 0: index and result of a work item
+
+}  // namespace
+
+// Work items are all pairs (instance file, task), in the order run writes
+// them; every rank enumerates them the same way, so only their index is
+// sent. Rank 0 hands out one item to each worker, and the next one whenever
+// a worker returns a result, so that long runs (e.g. CPLEX or CASANOVA) do
+// not hold up the other workers. Results are written in item order, as soon
+// as all previous items are written.
+void Runner::runDistributed(InputParams params) {
+  mpi::communicator world;
+  // without --seed, each rank drew its own master seed
+  mpi::broadcast(world, params.seed, 0);
+  auto tasks = tasksOf(params);
+  int items = params.infiles.size() * tasks.size();
+
+  if (world.rank() == 0) {
+    StatsWriter writer(params.outfile, headerOf(params, tasks));
+    std::map<int, Result> pending;
+    int next = 0, written = 0, busy = 0;
+    for (int worker = 1; worker < world.size(); ++worker) {
+      if (next < items) {
+        world.send(worker, WORK, next++);
+        ++busy;
+      } else {
+        world.send(worker, STOP, -1);
+      }
+    }
+    while (busy > 0) {
+      std::pair<int, Result> done;
+      mpi::status status = world.recv(mpi::any_source, RESULT, done);
+      if (next < items) {
+        world.send(status.source(), WORK, next++);
+      } else {
+        world.send(status.source(), STOP, -1);
+        --busy;
+      }
+      pending[done.first] = done.second;
+      for (auto it = pending.find(written); it != pending.end();
+           it = pending.find(written)) {
+        writeResult(it->second, writer);
+        pending.erase(it);
+        ++written;
+      }
+    }
+  } else {
+    // consecutive items mostly share an instance file, so the instances of
+    // the last one loaded are kept along with their samples
+    int file = -1;
+    std::vector<std::pair<std::string, std::vector<Job>>> instances;
+    while (true) {
+      int item;
+      mpi::status status = world.recv(0, mpi::any_tag, item);
+      if (status.tag() == STOP) break;
+
+      // the task is run on all instances of a multi-document file
+      Result result;
+      int f = item / tasks.size(), k = item % tasks.size();
+      try {
+        if (file != f) {
+          instances.clear();
+          loadInstances(params.infiles[f],
+                        [&](InstancePtr instance, std::string name) {
+                          instances.emplace_back(name, jobsOf(instance, tasks));
+                        });
+          file = f;
+        }
+        for (auto& instance : instances) {
+          const Job& job = instance.second[k];
+          auto result_of = [&](unsigned int run) {
+            return solve(job.instance, job.type, params, run,
+                         params.algo_threads);
+          };
+          unsigned int nruns = isStochastic(job.type) ? 10 : 1;
+          Result part =
+              collectResult(result_of, nruns, job.type, instance.first,
+                            job.sampling_ratio, *params.format);
+          result.rows += part.rows;
+          if (part.error != "")
+            result.error += (result.error != "" ? "\n" : "") + part.error;
+        }
+      } catch (std::exception& e) {
+        file = -1;
+        instances.clear();
+        result.error = std::string("[ERROR] ") + e.what();
+      }
+      world.send(0, RESULT, std::make_pair(item, result));
+    }
+  }
+}
@@ -0,0 +1,143 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/stats_writer.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// JSON string literal
+std::string quote(const std::string& s) {
+  const char* hex = "0123456789abcdef";
+  std::ostringstream out;
+  out << '"';
+  for (unsigned char c : s) {
+    if (c == '"' || c == '\\')
+      out << '\\' << c;
+    else if (c < 0x20)
+      out << "\\u00" << hex[c >> 4] << hex[c & 15];
+    else
+      out << c;
+  }
+  out << '"';
+  return out.str();
+}
+
+// JSON has no literals for infinite or NaN values
+void number(std::ostream& out, double x) {
+  if (std::isfinite(x))
+    out << x;
+  else
+    out << "null";
+}
+
+}  // namespace
+
+constexpr std::chrono::milliseconds StatsWriter::flush_interval;
+
+StatsWriter::StatsWriter(std::string outfile, std::string header)
+    : out(&std::cout) {
+  if (outfile != "") {
+    fout.open(outfile, std::ios::app);
+    if (!fout) throw std::runtime_error("cannot open output file " + outfile);
+    out = &fout;
+    // outputs that cannot seek, e.g. pipes, are taken as empty
+    bool empty = !fout.seekp(0, std::ios::end) || fout.tellp() == 0;
+    fout.clear();
+    if (header != "" && empty) fout << header << std::endl;
+  }
+  writer = std::thread(&StatsWriter::work, this);
+}
+
+StatsWriter::~StatsWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  condition.notify_one();
+  writer.join();
+}
+
+void StatsWriter::write(const std::string& rows) {
+  if (rows == "") return;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queued += rows;
+  }
+  condition.notify_one();
+}
+
+// Takes all queued rows at once and writes them with a single flush, then
+// lets rows accumulate for a flush interval, unless the writer is stopped.
+void StatsWriter::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    condition.wait(lock, [this]() { return stop || !queued.empty(); });
+    if (queued.empty()) break;  // stopped, nothing left to write
+    std::string batch;
+    batch.swap(queued);
+    lock.unlock();
+    *out << batch << std::flush;
+    lock.lock();
+    condition.wait_for(lock, flush_interval, [this]() { return stop; });
+  }
+}
+
+std::string StatsWriter::header(OutputFormat format, bool sampled) {
+  if (format != +OutputFormat::CSV) return "";
+  std::string columns =
+      "infile,algorithm,time_wdp,welfare,num_goods_traded,num_winners,"
+      "mean_utility,stddev_utility,avg_unit_price";
+  if (sampled) return "sampling_ratio," + columns;
+  return columns;
+}
+
+std::string StatsWriter::formatRow(const Stats& stats, AuctionType type,
+                                   std::string infile, double sampling_ratio,
+                                   OutputFormat format) {
+  std::ostringstream row;
+  switch (format) {
+    case OutputFormat::CSV:
+      if (sampling_ratio != 1.0) row << sampling_ratio << ",";
+      row << infile << "," << type << stats << "\n";
+      break;
+    case OutputFormat::JSONL:
+      row << "{";
+      if (sampling_ratio != 1.0)
+        row << "\"sampling_ratio\":" << sampling_ratio << ",";
+      row << "\"infile\":" << quote(infile) << ",";
+      row << "\"algorithm\":\"" << type << "\",";
+      row << "\"time_wdp\":";
+      number(row, stats.getTimeWdp());
+      row << ",\"welfare\":";
+      number(row, stats.getWelfare());
+      row << ",\"num_goods_traded\":" << stats.getNumGoodsTraded();
+      row << ",\"num_winners\":" << stats.getNumWinners();
+      row << ",\"mean_utility\":";
+      number(row, stats.getMeanUtility());
+      row << ",\"stddev_utility\":";
+      number(row, stats.getStddevUtility());
+      row << ",\"avg_unit_price\":";
+      number(row, stats.getAvgUnitPrice());
+      row << "}\n";
+      break;
+  }
+  return row.str();
+}
@@ -0,0 +1,68 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_STATS_WRITER_H_
+#define SRC_STATS_WRITER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "src/helper.h"
+#include "src/stats.h"
+
+// Writes stats rows to an output file, or to standard out, from a background
+// thread. The file is opened once; rows queued by any number of threads are
+// written and flushed in batches, at most once per flush interval, so that
+// producers never wait for the output.
+class StatsWriter {
+ public:
+  // @param outfile the output file, rows are appended; standard out if empty
+  // @param header first line of a new (empty) output file, none if empty
+  StatsWriter(std::string outfile, std::string header);
+  ~StatsWriter();  // writes all queued rows
+
+  // queues complete rows, each terminated by a newline
+  void write(const std::string& rows);
+
+  // @param sampled whether the rows start with the sampling ratio
+  // @return the header line of the format, empty if the format has none
+  static std::string header(OutputFormat format, bool sampled);
+  // @return one row in the given format, terminated by a newline
+  static std::string formatRow(const Stats& stats, AuctionType type,
+                               std::string infile, double sampling_ratio,
+                               OutputFormat format);
+
+  static constexpr std::chrono::milliseconds flush_interval{200};
+
+ private:
+  void work();
+
+  std::ofstream fout;
+  std::ostream* out;
+  std::string queued;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stop = false;
+  std::thread writer;
+};
+
+#endif  // SRC_STATS_WRITER_H_
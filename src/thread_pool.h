@@ -0,0 +1,109 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_THREAD_POOL_H_
+#define SRC_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads executing submitted tasks in FIFO order.
+// A pool of size 0 is valid: parallelFor then runs on the calling thread.
+class ThreadPool {
+ public:
+  ThreadPool(unsigned int num_threads);
+  ~ThreadPool();
+
+  inline unsigned int size() const { return workers.size(); }
+
+  // queues a task; its result (or exception) is returned through the future
+  template <class F>
+  auto submit(F task) -> std::future<decltype(task())> {
+    typedef decltype(task()) R;
+    auto packaged = std::make_shared<std::packaged_task<R()>>(task);
+    std::future<R> result = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push([packaged]() { (*packaged)(); });
+    }
+    condition.notify_one();
+    return result;
+  }
+
+  // calls f(k) for all k in [begin, end), in chunks of at least grain
+  // indices; the calling thread takes part and the call blocks until done
+  template <class F>
+  void parallelFor(unsigned int begin, unsigned int end, F f,
+                   unsigned int grain = 1) {
+    if (begin >= end) return;
+    unsigned int chunk = std::max(grain, (end - begin) / (4 * (size() + 1)));
+    if (size() == 0 || end - begin <= chunk) {
+      for (unsigned int k = begin; k < end; ++k) f(k);
+      return;
+    }
+    auto next = std::make_shared<std::atomic<unsigned int>>(begin);
+    auto loop = [next, end, chunk, &f]() {
+      unsigned int first;
+      while ((first = next->fetch_add(chunk)) < end) {
+        unsigned int last = std::min(end, first + chunk);
+        for (unsigned int k = first; k < last; ++k) f(k);
+      }
+    };
+    unsigned int num_tasks =
+        std::min(size(), (end - begin + chunk - 1) / chunk - 1);
+    std::vector<std::future<void>> pending;
+    for (unsigned int t = 0; t < num_tasks; ++t) pending.push_back(submit(loop));
+    // always wait for all tasks, since they refer to f
+    std::exception_ptr error;
+    try {
+      loop();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (auto& p : pending) {
+      try {
+        p.get();
+      } catch (...) {
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  // number of hardware threads, at least 1
+  static unsigned int hardwareThreads();
+
+ private:
+  void work();
+
+  std::vector<std::thread> workers;
+  std::queue<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stop = false;
+};
+
+#endif  // SRC_THREAD_POOL_H_
@@ -0,0 +1,157 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/vcg_pricing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "src/ordered_compatibility.h"
+
+VCGPricing::VCGPricing(const Instance &instance,
+                       const std::vector<std::pair<int, int>> &pairs,
+                       unsigned int num_threads) {
+  computeEdges(instance, pairs, std::max(1u, num_threads));
+  computeComponents();
+  computePrices();
+}
+
+void VCGPricing::computeEdges(const Instance &instance,
+                              const std::vector<std::pair<int, int>> &pairs,
+                              unsigned int num_threads) {
+  unsigned int n = instance.getBids().N();
+  unsigned int m = instance.getAsks().N();
+  std::vector<int> asks(m);
+  std::iota(asks.begin(), asks.end(), 0);
+  auto compatible_asks = instance.orderedCompatibility(true, asks);
+
+  // pair of each allocated bid and ask, and the allocated asks as a subset
+  std::vector<int> pair_of_bid(n, -1);
+  std::vector<int> pair_of_ask(m, -1);
+  std::vector<uint64_t> allocated(compatible_asks->W(), 0);
+  for (unsigned int k = 0; k < pairs.size(); ++k) {
+    pair_of_bid[pairs[k].first] = k;
+    pair_of_ask[pairs[k].second] = k;
+    compatible_asks->toggle(allocated, pairs[k].second);
+  }
+  std::vector<uint64_t> free = compatible_asks->all();
+  for (unsigned int w = 0; w < free.size(); ++w) free[w] &= ~allocated[w];
+
+  successors.assign(pairs.size(), std::vector<unsigned int>());
+  high.resize(pairs.size());
+  low.resize(pairs.size());
+  ThreadPool pool(num_threads - 1);
+  pool.parallelFor(0, pairs.size(), [&](unsigned int k) {
+    int i = pairs[k].first;
+    high[k] = instance.getAsks().V()[pairs[k].second];
+    low[k] = instance.getBids().V()[i];
+    for (unsigned int p = compatible_asks->first(i, allocated); p < m;
+         p = compatible_asks->next(i, p + 1, allocated))
+      if (pair_of_ask[p] != int(k)) successors[k].push_back(pair_of_ask[p]);
+    for (unsigned int p = compatible_asks->first(i, free); p < m;
+         p = compatible_asks->next(i, p + 1, free))
+      low[k] = std::min(low[k], instance.getAsks().V()[p]);
+  });
+  // the unallocated bids raise the ends of the asks they are compatible with
+  for (unsigned int i = 0; i < n; ++i) {
+    if (pair_of_bid[i] >= 0) continue;
+    for (unsigned int p = compatible_asks->first(i, allocated); p < m;
+         p = compatible_asks->next(i, p + 1, allocated))
+      high[pair_of_ask[p]] =
+          std::max(high[pair_of_ask[p]], instance.getBids().V()[i]);
+  }
+}
+
+// Tarjan's algorithm, without recursion: a component is complete after all
+// components reachable from it.
+void VCGPricing::computeComponents() {
+  unsigned int size = successors.size();
+  const unsigned int unvisited = size;
+  std::vector<unsigned int> index(size, unvisited);
+  std::vector<unsigned int> lowlink(size);
+  std::vector<unsigned int> stack;
+  std::vector<char> on_stack(size, 0);
+  // pairs being visited, with the next successor to look at
+  std::vector<std::pair<unsigned int, unsigned int>> path;
+  unsigned int counter = 0;
+
+  component.assign(size, 0);
+  num_components = 0;
+  auto visit = [&](unsigned int p) {
+    index[p] = lowlink[p] = counter++;
+    stack.push_back(p);
+    on_stack[p] = 1;
+    path.push_back({p, 0});
+  };
+  for (unsigned int root = 0; root < size; ++root) {
+    if (index[root] != unvisited) continue;
+    visit(root);
+    while (!path.empty()) {
+      unsigned int p = path.back().first;
+      if (path.back().second < successors[p].size()) {
+        unsigned int q = successors[p][path.back().second++];
+        if (index[q] == unvisited)
+          visit(q);
+        else if (on_stack[q])
+          lowlink[p] = std::min(lowlink[p], index[q]);
+        continue;
+      }
+      path.pop_back();
+      if (!path.empty())
+        lowlink[path.back().first] =
+            std::min(lowlink[path.back().first], lowlink[p]);
+      if (lowlink[p] != index[p]) continue;
+      // p is the root of a component
+      unsigned int q;
+      do {
+        q = stack.back();
+        stack.pop_back();
+        on_stack[q] = 0;
+        component[q] = num_components;
+      } while (q != p);
+      ++num_components;
+    }
+  }
+}
+
+void VCGPricing::computePrices() {
+  highest.assign(num_components, 0.);
+  lowest.assign(num_components, 0.);
+  std::vector<std::vector<unsigned int>> members(num_components);
+  for (unsigned int p = 0; p < component.size(); ++p) {
+    unsigned int c = component[p];
+    if (members[c].empty()) {
+      highest[c] = high[p];
+      lowest[c] = low[p];
+    }
+    highest[c] = std::max(highest[c], high[p]);
+    lowest[c] = std::min(lowest[c], low[p]);
+    members[c].push_back(p);
+  }
+  // the components reachable from c have lower numbers: the lowest end
+  // reachable is complete for them when c is reached
+  for (unsigned int c = 0; c < num_components; ++c)
+    for (unsigned int p : members[c])
+      for (unsigned int q : successors[p])
+        lowest[c] = std::min(lowest[c], lowest[component[q]]);
+  // conversely, the components reaching c have higher numbers
+  for (unsigned int c = num_components; c-- > 0;)
+    for (unsigned int p : members[c])
+      for (unsigned int q : successors[p])
+        highest[component[q]] = std::max(highest[component[q]], highest[c]);
+}
@@ -0,0 +1,85 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_VCG_PRICING_H_
+#define SRC_VCG_PRICING_H_
+
+#include <utility>
+#include <vector>
+
+#include "src/instance.h"
+#include "src/thread_pool.h"
+
+// Vickrey-Clarke-Groves payments of the winners of an allocation, each pair
+// repaired by one augmenting path instead of re-solving without the winner.
+//
+// Without the bid of a pair (i, j), the best repair frees ask j and moves
+// along an alternating path: ask j goes to a compatible bid b1, whose ask
+// a1 goes to a compatible bid b2, and so on, until an ask a is left free or
+// goes to an unallocated bid b. Along the path, the welfare changes
+// telescope to V_a - V_j (or V_b - V_j), so bid i pays the highest V_a or
+// V_b at the end of such a path. Likewise, ask j receives the lowest bid or
+// free ask value at the end of a path from bid i. If the allocation is
+// optimal, these are the VCG payments; for a heuristic allocation, they are
+// relative to it.
+//
+// The paths use the graph where pair p points to pair q if the bid of p is
+// compatible with the ask of q, which does not depend on the winner. The
+// payments of all winners are found at once on its strongly connected
+// components, in time linear in the graph; the edges are computed in
+// parallel.
+class VCGPricing {
+ public:
+  // @param pairs the allocated (bid, ask) pairs
+  // @param num_threads threads computing the edges, including the calling one
+  VCGPricing(const Instance &instance,
+             const std::vector<std::pair<int, int>> &pairs,
+             unsigned int num_threads);
+
+  // payment of the bid of pair k, and payment received by its ask
+  inline double buyerPrice(unsigned int k) const {
+    return highest[component[k]];
+  }
+  inline double sellerPrice(unsigned int k) const {
+    return lowest[component[k]];
+  }
+
+ private:
+  void computeEdges(const Instance &instance,
+                    const std::vector<std::pair<int, int>> &pairs,
+                    unsigned int num_threads);
+  void computeComponents();
+  void computePrices();
+
+  // pair q is a successor of pair p if the bid of p is compatible with the
+  // ask of q
+  std::vector<std::vector<unsigned int>> successors;
+  // value of the best path end after each pair: the highest value of its
+  // ask and the unallocated bids compatible with it, and the lowest value
+  // of its bid and the free asks compatible with it
+  std::vector<double> high;
+  std::vector<double> low;
+
+  // strongly connected component of each pair, numbered such that the
+  // components reachable from one have lower numbers
+  std::vector<unsigned int> component;
+  unsigned int num_components = 0;
+  std::vector<double> highest;  // of the components reaching a component
+  std::vector<double> lowest;   // of the components reachable from one
+};
+
+#endif  // SRC_VCG_PRICING_H_
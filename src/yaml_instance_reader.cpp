@@ -0,0 +1,216 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "src/yaml_instance_reader.h"
+
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+std::invalid_argument error(const YAML::Mark &mark, const std::string &what) {
+  return std::invalid_argument("line " + std::to_string(mark.line + 1) +
+                               ": " + what);
+}
+
+double parseValue(const YAML::Mark &mark, const std::string &s) {
+  char *end;
+  double v = std::strtod(s.c_str(), &end);
+  if (s.empty() || *end) throw error(mark, "invalid value " + s);
+  return v;
+}
+
+unsigned int parseQuantity(const YAML::Mark &mark, const std::string &s) {
+  char *end;
+  unsigned long q = std::strtoul(s.c_str(), &end, 10);
+  if (s.empty() || *end || s[0] == '-' || q > UINT_MAX)
+    throw error(mark, "invalid quantity " + s);
+  return q;
+}
+
+}  // namespace
+
+YamlInstanceReader::YamlInstanceReader(std::string filename)
+    : in(filename), parser(in) {
+  if (!in) throw std::runtime_error("bad file: " + filename);
+}
+
+bool YamlInstanceReader::next(BidSet &bids, BidSet &asks) {
+  Handler handler;
+  while (parser.HandleNextDocument(handler)) {
+    // e.g. an empty document after a trailing separator
+    if (!handler.bids.found && !handler.asks.found) continue;
+    bids = handler.bids.finish("bids");
+    asks = handler.asks.finish("asks");
+    if (bids.L() != asks.L())
+      throw std::invalid_argument("bids and asks differ in resources");
+    return true;
+  }
+  return false;
+}
+
+BidSet YamlInstanceReader::PartialBidSet::finish(const std::string &name) {
+  if (!found) throw std::invalid_argument("missing " + name);
+  if (values.size() != n)
+    throw std::invalid_argument("values and quantities of " + name +
+                                " differ in length");
+  rows->shrink_to_fit();
+  return BidSet(values, std::shared_ptr<const unsigned int>(rows, rows->data()),
+                l);
+}
+
+void YamlInstanceReader::Handler::OnDocumentStart(const YAML::Mark &) {
+  stack.clear();
+  current = nullptr;
+  bids = PartialBidSet();
+  asks = PartialBidSet();
+}
+
+void YamlInstanceReader::Handler::OnNull(const YAML::Mark &mark,
+                                         YAML::anchor_t) {
+  value(mark, "", true);
+}
+
+void YamlInstanceReader::Handler::OnAlias(const YAML::Mark &mark,
+                                          YAML::anchor_t) {
+  // aliases only occur in the parameters of the generator
+  value(mark, "", true);
+}
+
+void YamlInstanceReader::Handler::OnScalar(const YAML::Mark &mark,
+                                           const std::string &,
+                                           YAML::anchor_t,
+                                           const std::string &value) {
+  this->value(mark, value, false);
+}
+
+void YamlInstanceReader::Handler::OnSequenceStart(const YAML::Mark &mark,
+                                                  const std::string &,
+                                                  YAML::anchor_t,
+                                                  YAML::EmitterStyle::value) {
+  if (!stack.empty() && (stack.back().role == VALUES ||
+                         stack.back().role == ROW))
+    throw error(mark, "nested sequence in values or quantities");
+  push(childRole(false), false);
+}
+
+void YamlInstanceReader::Handler::OnSequenceEnd() { pop(); }
+
+void YamlInstanceReader::Handler::OnMapStart(const YAML::Mark &mark,
+                                             const std::string &,
+                                             YAML::anchor_t,
+                                             YAML::EmitterStyle::value) {
+  Role parent = stack.empty() ? SKIP : stack.back().role;
+  if (parent == VALUES || parent == QUANTITIES || parent == ROW)
+    throw error(mark, "map in values or quantities");
+  if (!stack.empty() && stack.back().map && stack.back().key_next)
+    throw error(mark, "complex keys are not supported");
+  push(childRole(true), true);
+}
+
+void YamlInstanceReader::Handler::OnMapEnd() { pop(); }
+
+// Role of a collection starting at the current position.
+// @param map whether the collection is a map or a sequence
+YamlInstanceReader::Role YamlInstanceReader::Handler::childRole(
+    bool map) const {
+  if (stack.empty()) return map ? ROOT : SKIP;
+  const Frame &parent = stack.back();
+  switch (parent.role) {
+    case ROOT:
+      if (map && (parent.key == "bids" || parent.key == "asks")) return BIDSET;
+      return SKIP;
+    case BIDSET:
+      if (!map && parent.key == "values") return VALUES;
+      if (!map && parent.key == "quantities") return QUANTITIES;
+      return SKIP;
+    case QUANTITIES:
+      return ROW;
+    default:
+      return SKIP;
+  }
+}
+
+// Handles a scalar (or null, or alias): a map key, or a value that is stored
+// if it belongs to the values or quantities of a bid set.
+void YamlInstanceReader::Handler::value(const YAML::Mark &mark,
+                                        const std::string &value, bool null) {
+  if (stack.empty()) return;
+  Frame &top = stack.back();
+  if (top.map && top.key_next) {
+    top.key = value;
+    top.key_next = false;
+    return;
+  }
+  if (top.map) top.key_next = true;
+
+  switch (top.role) {
+    case VALUES:
+      if (null) throw error(mark, "missing value");
+      current->values.push_back(parseValue(mark, value));
+      break;
+    case QUANTITIES:
+      throw error(mark, "quantities must be sequences");
+    case ROW:
+      if (null) throw error(mark, "missing quantity");
+      if (current->n == 0) {
+        current->first_row.push_back(parseQuantity(mark, value));
+      } else {
+        if (current->k >= current->l)
+          throw error(mark, "rows differ in length");
+        unsigned long offset = (unsigned long)current->n * current->stride;
+        (*current->rows)[offset + current->k++] = parseQuantity(mark, value);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void YamlInstanceReader::Handler::push(Role role, bool map) {
+  if (role == BIDSET) {
+    current = stack.back().key == "bids" ? &bids : &asks;
+    if (current->found)
+      throw std::invalid_argument("duplicate " + stack.back().key);
+    current->found = true;
+    current->rows = std::make_shared<AlignedVector<unsigned int>>();
+  } else if (role == ROW && current->n > 0) {
+    // the stride is known after the first row
+    current->rows->resize((unsigned long)(current->n + 1) * current->stride, 0);
+    current->k = 0;
+  }
+  stack.push_back(Frame{role, map, map, ""});
+}
+
+void YamlInstanceReader::Handler::pop() {
+  Role role = stack.back().role;
+  stack.pop_back();
+  if (role == ROW) {
+    PartialBidSet &set = *current;
+    if (set.n == 0) {
+      set.l = set.first_row.size();
+      set.stride = paddedLength(set.l);
+      set.rows->resize(set.stride, 0);
+      std::copy(set.first_row.begin(), set.first_row.end(), set.rows->begin());
+    } else if (set.k != set.l) {
+      throw std::invalid_argument("rows of quantities differ in length");
+    }
+    ++set.n;
+  }
+  if (!stack.empty() && stack.back().map) stack.back().key_next = true;
+}
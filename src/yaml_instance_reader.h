@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef SRC_YAML_INSTANCE_READER_H_
+#define SRC_YAML_INSTANCE_READER_H_
+
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/mark.h>
+#include <yaml-cpp/parser.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "src/bid_set.h"
+
+// Reads the instances of a YAML file, one per document, from the events of
+// the yaml-cpp parser. Values and quantity rows go straight into the storage
+// of the bid sets; no YAML::Node tree is built. Only the values and
+// quantities of the bids and asks are read, all other keys are skipped.
+class YamlInstanceReader {
+ public:
+  explicit YamlInstanceReader(std::string filename);
+
+  // reads the next document of the file
+  // @return false if there are no documents left
+  bool next(BidSet &bids, BidSet &asks);
+
+ private:
+  // where the parser is in a document, given by the keys on the way there
+  enum Role { SKIP, ROOT, BIDSET, VALUES, QUANTITIES, ROW };
+
+  // a bid set while it is read
+  struct PartialBidSet {
+    bool found = false;
+    std::vector<double> values;
+    std::vector<unsigned int> first_row;  // read before the stride is known
+    unsigned int n = 0, l = 0, stride = 0;
+    unsigned int k = 0;  // position in the current row
+    std::shared_ptr<AlignedVector<unsigned int>> rows;
+
+    BidSet finish(const std::string &name);
+  };
+
+  class Handler : public YAML::EventHandler {
+   public:
+    PartialBidSet bids, asks;
+
+    void OnDocumentStart(const YAML::Mark &mark) override;
+    void OnDocumentEnd() override {}
+    void OnNull(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+    void OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+    void OnScalar(const YAML::Mark &mark, const std::string &tag,
+                  YAML::anchor_t anchor, const std::string &value) override;
+    void OnSequenceStart(const YAML::Mark &mark, const std::string &tag,
+                         YAML::anchor_t anchor,
+                         YAML::EmitterStyle::value style) override;
+    void OnSequenceEnd() override;
+    void OnMapStart(const YAML::Mark &mark, const std::string &tag,
+                    YAML::anchor_t anchor,
+                    YAML::EmitterStyle::value style) override;
+    void OnMapEnd() override;
+
+   private:
+    struct Frame {
+      Role role;
+      bool map;
+      bool key_next;    // the next scalar of a map is a key
+      std::string key;  // key of the current value
+    };
+    std::vector<Frame> stack;
+    PartialBidSet *current = nullptr;  // bid set being read
+
+    Role childRole(bool map) const;
+    void value(const YAML::Mark &mark, const std::string &value, bool null);
+    void push(Role role, bool map);
+    void pop();
+  };
+
+  std::ifstream in;
+  YAML::Parser parser;
+};
+
+#endif  // SRC_YAML_INSTANCE_READER_H_
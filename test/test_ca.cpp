@@ -19,6 +19,9 @@
 
 #include <cppunit/TestAssert.h>
 
+#include <algorithm>
+#include <memory>
+
 #include "src/ca_factory.h"
 
 void TestCA::testNoOversell(void) {
@@ -111,19 +114,113 @@ void TestCA::testDeterministic(void) {
   std::cout << "[" << type << "] Deterministic allocation" << std::endl;
 }
 
+void TestCA::testThreads(void) {
+  // stochastic algorithms get the same seed in both runs
+  mTestObj->setSeed(1);
+  mTestObj->run();
+  auto y1 = mTestObj->getAllocation();
+  mTestObj->setThreads(4);
+  mTestObj->run();
+  auto y2 = mTestObj->getAllocation();
+  for (unsigned int j = 0; j < m; ++j) {
+    for (unsigned int i = 0; i < n; ++i) {
+      CPPUNIT_ASSERT(y1(i, j) == y2(i, j));
+    }
+  }
+  std::cout << "[" << type << "] Same allocation with threads" << std::endl;
+}
+
+void TestCA::testIndex(void) {
+  // the same algorithm on the instance without compatibility index
+  auto plain = std::make_shared<Instance>("test/test_dataset_small");
+  CA *other = CAFactory::createAuction(plain, type);
+  other->setPricing(pricing);
+  mTestObj->setSeed(1);
+  mTestObj->run();
+  other->setSeed(1);
+  other->run();
+  auto y1 = mTestObj->getAllocation();
+  auto y2 = other->getAllocation();
+  delete other;
+  for (unsigned int j = 0; j < m; ++j) {
+    for (unsigned int i = 0; i < n; ++i) {
+      CPPUNIT_ASSERT(y1(i, j) == y2(i, j));
+    }
+  }
+  std::cout << "[" << type << "] Same allocation without index" << std::endl;
+}
+
+// @return the welfare of an allocation
+static double welfareOf(const Instance &instance, const Allocation &y) {
+  double welfare = 0.;
+  for (unsigned int i = 0; i < instance.getBids().N(); ++i)
+    if (y.askOf(i) >= 0)
+      welfare += instance.getBids().V()[i] - instance.getAsks().V()[y.askOf(i)];
+  return welfare;
+}
+
+// @return the instance with the value of a bid, or an ask, replaced
+static InstancePtr withValue(const Instance &instance, bool of_bid, int k,
+                             double value) {
+  auto copy = [&](const BidSet &set, bool changed) {
+    std::vector<double> v = set.V();
+    if (changed) v[k] = value;
+    boost::numeric::ublas::matrix<int> q(set.N(), set.L());
+    for (unsigned int i = 0; i < set.N(); ++i)
+      for (unsigned int r = 0; r < set.L(); ++r) q(i, r) = set.Q()(i, r);
+    return BidSet(v, q);
+  };
+  return std::make_shared<Instance>(copy(instance.getBids(), of_bid),
+                                    copy(instance.getAsks(), !of_bid));
+}
+
+// The optimal welfare without a winner is found by solving again with a bid
+// of value 0, or an ask of a value above all bids, which are never allocated.
+void TestCA::testVCGPricing(void) {
+  mTestObj->run();
+  auto y = mTestObj->getAllocation();
+  auto price_buyer = mTestObj->getPricingBuyers();
+  auto price_seller = mTestObj->getPricingSellers();
+  double welfare = welfareOf(*instance, y);
+  auto optimum = [&](InstancePtr other) {
+    std::unique_ptr<CA> ca(CAFactory::createAuction(other, type));
+    ca->run();
+    return welfareOf(*other, ca->getAllocation());
+  };
+  double above = 1. + *std::max_element(instance->getBids().V().begin(),
+                                        instance->getBids().V().end());
+  for (unsigned int i = 0; i < n; ++i) {
+    int j = y.askOf(i);
+    if (j < 0) continue;
+    double v_i = instance->getBids().V()[i];
+    double v_j = instance->getAsks().V()[j];
+    // the others lose what the winner gains over their welfare without it
+    double without_bid = optimum(withValue(*instance, true, i, 0.));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(without_bid - (welfare - v_i), price_buyer[i],
+                                 1.e-6);
+    double without_ask = optimum(withValue(*instance, false, j, above));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(v_j + welfare - without_ask, price_seller[j],
+                                 1.e-6);
+  }
+  std::cout << "[" << type << "] VCG pricing" << std::endl;
+}
+
 void TestCA::setUp(void) {
-  // init instance
-  instance = new Instance("test/test_dataset_small");
+  // init instance, indexed like the instances of the runner
+  auto indexed = std::make_shared<Instance>("test/test_dataset_small");
+  indexed->buildCompatibilityIndex();
+  instance = indexed;
   n = instance->getBids().N();
   m = instance->getAsks().N();
   l = instance->L();
 
   // init auction object of a certain type
-  mTestObj = CAFactory::createAuction(*instance, type);
+  mTestObj = CAFactory::createAuction(instance, type);
+  mTestObj->setPricing(pricing);
 }
 
 void TestCA::tearDown(void) { delete mTestObj; }
 
-TestCA::TestCA() : type(AuctionType::GREEDY1) {}
+TestCA::TestCA() : type(AuctionType::GREEDY1), pricing(PricingMode::K) {}
 
-TestCA::~TestCA() { delete instance; }
+TestCA::~TestCA() {}
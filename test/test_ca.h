@@ -47,13 +47,21 @@ class TestCA : public CppUnit::TestFixture {
   void testResetAllocation(void);
   // check same results for deterministic algorithms
   void testDeterministic(void);
+  // check same results with several threads per run
+  void testThreads(void);
+  // check same results without compatibility index
+  void testIndex(void);
+  // check VCG prices of an optimal algorithm against solving again without
+  // each winner
+  void testVCGPricing(void);
 
  protected:
   unsigned int n;
   unsigned int m;
   unsigned int l;
-  Instance* instance;
+  InstancePtr instance;
   AuctionType type;
+  PricingMode pricing;
   CA* mTestObj;
 };
 
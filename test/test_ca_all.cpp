@@ -29,6 +29,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TestCAStochastic<TestCASA>);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestCAStochastic<TestCASAS>);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestCAStochastic<TestCACasanova>);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestCAStochastic<TestCACasanovaS>);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCAGeneric<TestCAMatching>);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCAGeneric<TestCABertsekas>);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCAStochastic<TestCASAPT>);
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCAVCG<TestCAMatchingVCG>);
 #ifdef _CPLEX
 CPPUNIT_TEST_SUITE_REGISTRATION(TestCAGeneric<TestCACplex>);
 CPPUNIT_TEST_SUITE_REGISTRATION(TestCAGeneric<TestCACplexRLPS>);
@@ -47,4 +51,11 @@ TestCASAS::TestCASAS() { type = AuctionType::SAS; }
 TestCACasanova::TestCACasanova() { type = AuctionType::CASANOVA; }
 TestCACasanovaS::TestCACasanovaS() { type = AuctionType::CASANOVAS; }
 TestCACplex::TestCACplex() { type = AuctionType::CPLEX; }
-TestCACplexRLPS::TestCACplexRLPS() { type = AuctionType::RLPS; }
\ No newline at end of file
+TestCACplexRLPS::TestCACplexRLPS() { type = AuctionType::RLPS; }
+TestCAMatching::TestCAMatching() { type = AuctionType::MATCHING; }
+TestCABertsekas::TestCABertsekas() { type = AuctionType::BERTSEKAS; }
+TestCASAPT::TestCASAPT() { type = AuctionType::SAPT; }
+TestCAMatchingVCG::TestCAMatchingVCG() {
+  type = AuctionType::MATCHING;
+  pricing = PricingMode::VCG;
+}
\ No newline at end of file
@@ -34,10 +34,23 @@ class TestCAGeneric : public A {
   CPPUNIT_TEST(testIndividualRationality);
   CPPUNIT_TEST(testSingleMindedSellers);
   CPPUNIT_TEST(testDeterministic);
+  CPPUNIT_TEST(testThreads);
+  CPPUNIT_TEST(testIndex);
   CPPUNIT_TEST(testResetAllocation);
   CPPUNIT_TEST_SUITE_END();
 };
 
+template <class A>
+class TestCAVCG : public A {
+  CPPUNIT_TEST_SUITE(TestCAVCG<A>);
+  CPPUNIT_TEST(testNoOversell);
+  CPPUNIT_TEST(testIndividualRationality);
+  CPPUNIT_TEST(testSingleMindedSellers);
+  CPPUNIT_TEST(testResetAllocation);
+  CPPUNIT_TEST(testVCGPricing);
+  CPPUNIT_TEST_SUITE_END();
+};
+
 template <class A>
 class TestCAStochastic : public A {
   CPPUNIT_TEST_SUITE(TestCAStochastic<A>);
@@ -45,6 +58,8 @@ class TestCAStochastic : public A {
   CPPUNIT_TEST(testBudgetBalance);
   CPPUNIT_TEST(testIndividualRationality);
   CPPUNIT_TEST(testSingleMindedSellers);
+  CPPUNIT_TEST(testThreads);
+  CPPUNIT_TEST(testIndex);
   CPPUNIT_TEST(testResetAllocation);
   CPPUNIT_TEST_SUITE_END();
 };
@@ -119,4 +134,24 @@ class TestCACplexRLPS : public TestCA {
   TestCACplexRLPS();
 };
 
+class TestCAMatching : public TestCA {
+ public:
+  TestCAMatching();
+};
+
+class TestCABertsekas : public TestCA {
+ public:
+  TestCABertsekas();
+};
+
+class TestCASAPT : public TestCA {
+ public:
+  TestCASAPT();
+};
+
+class TestCAMatchingVCG : public TestCA {
+ public:
+  TestCAMatchingVCG();
+};
+
 #endif  // TEST_TEST_CA_GENERIC_H_
\ No newline at end of file
@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "test/test_candidate_pairs.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "src/candidate_pairs.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCandidatePairs);
+
+void TestCandidatePairs::setUp(void) {
+  auto copy = std::make_shared<Instance>("test/test_dataset_small");
+  copy->buildCompatibilityIndex();
+  instance = copy;
+}
+
+// Allocates random candidates until none is left. After each allocation,
+// the candidates and their partners must be those found by scanning the
+// free followers in order for each unallocated leader.
+void TestCandidatePairs::checkAllocations(bool leaders_are_bids,
+                                          const std::vector<int> &followers) {
+  const BidSet &leader_set =
+      leaders_are_bids ? instance->getBids() : instance->getAsks();
+  const BidSet &follower_set =
+      leaders_are_bids ? instance->getAsks() : instance->getBids();
+  auto compatible = [&](int x, int y) {
+    return leaders_are_bids ? instance->canAllocate(x, y)
+                            : instance->canAllocate(y, x);
+  };
+  auto gain = [&](int x, int y) {
+    return leaders_are_bids ? leader_set.V()[x] - follower_set.V()[y]
+                            : follower_set.V()[y] - leader_set.V()[x];
+  };
+
+  CandidatePairs candidates(*instance, leaders_are_bids, followers);
+  std::vector<bool> allocated_leader(leader_set.N(), false);
+  std::vector<bool> allocated_follower(follower_set.N(), false);
+  std::mt19937 generator(1);
+  unsigned int num_allocated = 0;
+  while (true) {
+    std::set<int> expected;
+    for (unsigned int x = 0; x < leader_set.N(); ++x) {
+      if (allocated_leader[x]) continue;
+      for (int y : followers) {
+        if (allocated_follower[y] || !compatible(x, y)) continue;
+        if (gain(x, y) > 0) {
+          expected.insert(x);
+          CPPUNIT_ASSERT_EQUAL(y, candidates.partner(x));
+        }
+        break;
+      }
+    }
+    std::set<int> found;
+    for (unsigned int r = 0; r < candidates.size(); ++r)
+      found.insert(candidates.leader(r));
+    CPPUNIT_ASSERT_EQUAL((unsigned int)found.size(), candidates.size());
+    CPPUNIT_ASSERT(expected == found);
+    if (found.empty()) break;
+
+    std::uniform_int_distribution<unsigned int> pick(0, candidates.size() - 1);
+    int x = candidates.leader(pick(generator));
+    int y = candidates.partner(x);
+    CPPUNIT_ASSERT(!allocated_follower[y]);
+    candidates.allocate(x);
+    allocated_leader[x] = true;
+    allocated_follower[y] = true;
+    ++num_allocated;
+  }
+  CPPUNIT_ASSERT(num_allocated > 0);
+}
+
+void TestCandidatePairs::testBidsLead(void) {
+  std::vector<int> asks(instance->getAsks().N());
+  std::iota(asks.begin(), asks.end(), 0);
+  checkAllocations(true, asks);
+  // followers in another order, as after sorting by density
+  std::reverse(asks.begin(), asks.end());
+  checkAllocations(true, asks);
+}
+
+void TestCandidatePairs::testAsksLead(void) {
+  std::vector<int> bids(instance->getBids().N());
+  std::iota(bids.begin(), bids.end(), 0);
+  checkAllocations(false, bids);
+  std::reverse(bids.begin(), bids.end());
+  checkAllocations(false, bids);
+}
@@ -0,0 +1,52 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef TEST_TEST_CANDIDATE_PAIRS_H_
+#define TEST_TEST_CANDIDATE_PAIRS_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+#include <vector>
+
+#include "src/instance.h"
+
+class TestCandidatePairs : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestCandidatePairs);
+  CPPUNIT_TEST(testBidsLead);
+  CPPUNIT_TEST(testAsksLead);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp(void);
+
+ protected:
+  // check the maintained improving pairs against a scan after each
+  // allocation, with the bids as leaders
+  void testBidsLead(void);
+  // same, with the asks as leaders
+  void testAsksLead(void);
+
+  void checkAllocations(bool leaders_are_bids,
+                        const std::vector<int> &followers);
+
+  InstancePtr instance;
+};
+
+#endif  // TEST_TEST_CANDIDATE_PAIRS_H_
@@ -0,0 +1,180 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_compatibility_index.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <thread>
+#include <vector>
+
+#include "src/ca_factory.h"
+#include "src/ordered_compatibility.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCompatibilityIndex);
+
+void TestCompatibilityIndex::setUp(void) {
+  // 100 asks, so that the last word of a row is padded
+  instance = std::make_shared<Instance>("test/test_dataset_small");
+}
+
+void TestCompatibilityIndex::assertPairs(CompatibilityIndex &index) {
+  unsigned int n = instance->getBids().N(), m = instance->getAsks().N();
+  CPPUNIT_ASSERT_EQUAL(n, index.N());
+  CPPUNIT_ASSERT_EQUAL(m, index.M());
+  CPPUNIT_ASSERT_EQUAL((m + 63) / 64, index.W());
+  unsigned int compatible = 0;
+  for (unsigned int i = 0; i < n; ++i) {
+    for (unsigned int j = 0; j < m; ++j) {
+      CPPUNIT_ASSERT_EQUAL(instance->checkAllocate(i, j), index.get(i, j));
+      if (index.get(i, j)) ++compatible;
+    }
+    // the padding asks are never compatible
+    const uint64_t *row = index.row(i);
+    for (unsigned int j = m; j < 64 * index.W(); ++j)
+      CPPUNIT_ASSERT(!((row[j / 64] >> (j % 64)) & 1));
+  }
+  // both outcomes occur, so the test says something
+  CPPUNIT_ASSERT(compatible > 0 && compatible < n * m);
+}
+
+void TestCompatibilityIndex::testEager(void) {
+  CompatibilityIndex index(instance->getBids(), instance->getAsks(), false);
+  assertPairs(index);
+}
+
+void TestCompatibilityIndex::testLazy(void) {
+  CompatibilityIndex eager(instance->getBids(), instance->getAsks(), false);
+  CompatibilityIndex lazy(instance->getBids(), instance->getAsks(), true);
+  unsigned int n = instance->getBids().N();
+  std::size_t fresh = lazy.memoryUsage();
+
+  // every thread queries all rows, starting at a different bid
+  const unsigned int num_threads = 4;
+  std::vector<std::vector<const uint64_t *>> rows(
+      num_threads, std::vector<const uint64_t *>(n));
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < num_threads; ++t)
+    threads.emplace_back([&, t]() {
+      for (unsigned int k = 0; k < n; ++k) {
+        unsigned int i = (k + t * n / num_threads) % n;
+        rows[t][i] = lazy.row(i);
+      }
+    });
+  for (auto &thread : threads) thread.join();
+
+  for (unsigned int i = 0; i < n; ++i) {
+    // a row is computed once and then stays in place
+    for (unsigned int t = 1; t < num_threads; ++t)
+      CPPUNIT_ASSERT(rows[t][i] == rows[0][i]);
+    for (unsigned int w = 0; w < eager.W(); ++w)
+      CPPUNIT_ASSERT_EQUAL(eager.row(i)[w], rows[0][i][w]);
+  }
+  assertPairs(lazy);
+  // the lazy rows are counted once computed
+  CPPUNIT_ASSERT_EQUAL(fresh + n * eager.W() * sizeof(uint64_t),
+                       lazy.memoryUsage());
+}
+
+void TestCompatibilityIndex::testInstance(void) {
+  unsigned int n = instance->getBids().N(), m = instance->getAsks().N();
+  std::vector<std::vector<int>> expected(n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < m; ++j)
+      if (instance->checkAllocate(i, j)) expected[i].push_back(j);
+
+  CPPUNIT_ASSERT(!instance->hasCompatibilityIndex());
+  CPPUNIT_ASSERT(instance->compatibleRow(0) == nullptr);
+  CPPUNIT_ASSERT(instance->computeCompatibleAsks() == expected);
+
+  instance->buildCompatibilityIndex();
+  CPPUNIT_ASSERT(instance->hasCompatibilityIndex());
+  for (unsigned int i = 0; i < n; ++i) {
+    const uint64_t *row = instance->compatibleRow(i);
+    CPPUNIT_ASSERT(row != nullptr);
+    for (unsigned int j = 0; j < m; ++j) {
+      CPPUNIT_ASSERT_EQUAL(instance->checkAllocate(i, j),
+                           instance->canAllocate(i, j));
+      CPPUNIT_ASSERT_EQUAL(instance->canAllocate(i, j),
+                           bool((row[j / 64] >> (j % 64)) & 1));
+    }
+  }
+  CPPUNIT_ASSERT(instance->computeCompatibleAsks() == expected);
+
+  // copies share the index
+  Instance copy(*instance);
+  CPPUNIT_ASSERT(copy.compatibleRow(0) == instance->compatibleRow(0));
+}
+
+void TestCompatibilityIndex::testSample(void) {
+  instance->buildCompatibilityIndex();
+  for (double ratio : {0.3, 0.55, 1.}) {
+    auto sample = std::make_shared<const Instance>(instance->sample(ratio));
+    unsigned int n = sample->getBids().N(), m = sample->getAsks().N();
+    CPPUNIT_ASSERT(sample->hasCompatibilityIndex());
+    CPPUNIT_ASSERT(n <= instance->getBids().N());
+    CPPUNIT_ASSERT(m <= instance->getAsks().N());
+
+    std::vector<std::vector<int>> expected(n);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < m; ++j) {
+        CPPUNIT_ASSERT_EQUAL(sample->checkAllocate(i, j),
+                             sample->canAllocate(i, j));
+        if (sample->checkAllocate(i, j)) expected[i].push_back(j);
+      }
+    // the asks of the instance beyond the sample are left out
+    CPPUNIT_ASSERT(sample->computeCompatibleAsks() == expected);
+
+    // ordered rows over the asks in reverse order, and over the bids
+    std::vector<int> asks(m), bids(n);
+    for (unsigned int j = 0; j < m; ++j) asks[j] = m - 1 - j;
+    for (unsigned int i = 0; i < n; ++i) bids[i] = i;
+    auto by_bid = sample->orderedCompatibility(true, asks);
+    auto by_ask = sample->orderedCompatibility(false, bids);
+    CPPUNIT_ASSERT_EQUAL(m, by_bid->size());
+    CPPUNIT_ASSERT_EQUAL(n, by_ask->size());
+    for (unsigned int i = 0; i < n; ++i) {
+      unsigned int p = 0;
+      while (p < m && !sample->checkAllocate(i, asks[p])) ++p;
+      CPPUNIT_ASSERT_EQUAL(p, by_bid->next(i, 0));
+    }
+    for (unsigned int j = 0; j < m; ++j) {
+      unsigned int p = 0;
+      while (p < n && !sample->checkAllocate(bids[p], j)) ++p;
+      CPPUNIT_ASSERT_EQUAL(p, by_ask->next(j, 0));
+    }
+  }
+}
+
+void TestCompatibilityIndex::testOrdered(void) {
+  instance->buildCompatibilityIndex();
+  std::size_t bytes = instance->memoryUsage();
+  instance->buildOrderedCompatibilities();
+  std::size_t built = instance->memoryUsage();
+  CPPUNIT_ASSERT(built > bytes);
+  instance->buildOrderedCompatibilities();
+  CPPUNIT_ASSERT_EQUAL(built, instance->memoryUsage());
+
+  for (auto type : AuctionType::_values()) {
+    if (!isHeuristic(type)) continue;
+    CA *ca = CAFactory::createAuction(instance, type);
+    ca->setSeed(1);
+    ca->run();
+    delete ca;
+    // no run built an ordered compatibility of its own
+    CPPUNIT_ASSERT_EQUAL(built, instance->memoryUsage());
+  }
+}
@@ -0,0 +1,64 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_COMPATIBILITY_INDEX_H_
+#define TEST_TEST_COMPATIBILITY_INDEX_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+#include <memory>
+
+#include "src/compatibility_index.h"
+#include "src/instance.h"
+
+class TestCompatibilityIndex : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestCompatibilityIndex);
+  CPPUNIT_TEST(testEager);
+  CPPUNIT_TEST(testLazy);
+  CPPUNIT_TEST(testInstance);
+  CPPUNIT_TEST(testSample);
+  CPPUNIT_TEST(testOrdered);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp(void);
+
+ protected:
+  // check all pairs of the eager index against checkAllocate
+  void testEager(void);
+  // check the rows of the lazy index, queried concurrently, against the
+  // eager index
+  void testLazy(void);
+  // check canAllocate and computeCompatibleAsks of an instance with and
+  // without index against checkAllocate
+  void testInstance(void);
+  // check that a sample answered by the index of its instance gives the
+  // pairs of the sample only
+  void testSample(void);
+  // check that the heuristic algorithms find the ordered compatibilities
+  // built ahead of their runs, and that the memory usage counts them
+  void testOrdered(void);
+
+  // asserts that the index has the pairs given by checkAllocate
+  void assertPairs(CompatibilityIndex &index);
+
+  std::shared_ptr<Instance> instance;
+};
+
+#endif  // TEST_TEST_COMPATIBILITY_INDEX_H_
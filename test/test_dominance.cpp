@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_dominance.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dominance.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestDominance);
+
+void TestDominance::testPair(void) {
+  auto supported = supportedDominanceKernels();
+  CPPUNIT_ASSERT_EQUAL(std::string("scalar"), std::string(supported[0].name));
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<unsigned int> quantity(0, 3);
+  for (unsigned int l : {1u, 3u, 7u, 8u, 9u, 17u}) {
+    unsigned int length = paddedLength(l);
+    AlignedVector<unsigned int> ask(length, 0), bid(length, 0);
+    unsigned int both = 0;
+    for (unsigned int t = 0; t < 500; ++t) {
+      for (unsigned int k = 0; k < l; ++k) {
+        ask[k] = quantity(gen);
+        // mostly below the ask, so that dominance is not rare for large l
+        bid[k] = quantity(gen) ? ask[k] : quantity(gen);
+      }
+      bool expected = true;
+      for (unsigned int k = 0; k < l; ++k) expected &= bid[k] <= ask[k];
+      both += expected;
+      for (const auto &kernels : supported)
+        CPPUNIT_ASSERT_EQUAL(expected,
+                             kernels.pair(ask.data(), bid.data(), length));
+      CPPUNIT_ASSERT_EQUAL(expected, dominates(ask.data(), bid.data(), length));
+    }
+    CPPUNIT_ASSERT(both > 0 && both < 500);
+  }
+}
+
+void TestDominance::testBlock(void) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<unsigned int> quantity(0, 3);
+  for (unsigned int l : {1u, 3u, 9u}) {
+    for (unsigned int m : {1u, 63u, 64u, 100u, 130u}) {
+      // asks resource by resource, padded with zeros to whole blocks
+      unsigned int stride = (m + 63) / 64 * 64;
+      AlignedVector<unsigned int> asks(l * stride, 0);
+      for (unsigned int k = 0; k < l; ++k)
+        for (unsigned int a = 0; a < m; ++a)
+          asks[k * stride + a] = quantity(gen);
+      std::vector<unsigned int> bid(l);
+      for (unsigned int t = 0; t < 20; ++t) {
+        for (unsigned int k = 0; k < l; ++k) bid[k] = quantity(gen) / 2;
+        for (unsigned int w = 0; w < stride / 64; ++w) {
+          const unsigned int *block = &asks[w * 64];
+          uint64_t expected = 0;
+          for (unsigned int a = 0; a < 64; ++a) {
+            bool ok = true;
+            for (unsigned int k = 0; k < l; ++k)
+              ok &= bid[k] <= block[k * stride + a];
+            expected |= (uint64_t)ok << a;
+          }
+          for (const auto &kernels : supportedDominanceKernels())
+            CPPUNIT_ASSERT_EQUAL(expected,
+                                 kernels.block(bid.data(), l, block, stride));
+          CPPUNIT_ASSERT_EQUAL(expected,
+                               dominatesBlock(bid.data(), l, block, stride));
+        }
+      }
+    }
+  }
+}
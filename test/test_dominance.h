@@ -0,0 +1,40 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_DOMINANCE_H_
+#define TEST_TEST_DOMINANCE_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+class TestDominance : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestDominance);
+  CPPUNIT_TEST(testPair);
+  CPPUNIT_TEST(testBlock);
+  CPPUNIT_TEST_SUITE_END();
+
+ protected:
+  // check the pair kernels of all supported variants against a scalar
+  // reference, for numbers of resources that are not multiples of 8
+  void testPair(void);
+  // check the block kernels of all supported variants against a scalar
+  // reference, for numbers of asks that are not multiples of 64
+  void testBlock(void);
+};
+
+#endif  // TEST_TEST_DOMINANCE_H_
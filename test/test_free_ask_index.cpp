@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_free_ask_index.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "src/free_ask_index.h"
+#include "src/instance.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFreeAskIndex);
+
+void TestFreeAskIndex::testReset(void) {
+  Instance instance("test/test_dataset_small");
+  unsigned int m = instance.getAsks().N();
+  std::vector<int> order(m);
+  std::iota(order.begin(), order.end(), 0);
+  FreeAskIndex index(instance.getAsks(), order);
+  CPPUNIT_ASSERT_EQUAL(m, index.size());
+  for (unsigned int j = 0; j < m; ++j) index.erase(j);
+  CPPUNIT_ASSERT_EQUAL(0u, index.size());
+  CPPUNIT_ASSERT_EQUAL(-1, index.findFirst(instance.getBids(), 0));
+  index.reset();
+  CPPUNIT_ASSERT_EQUAL(m, index.size());
+  for (unsigned int j = 0; j < m; ++j) CPPUNIT_ASSERT(index.contains(j));
+}
+
+void TestFreeAskIndex::testFindFirst(void) {
+  Instance instance("test/test_dataset_small");
+  unsigned int n = instance.getBids().N(), m = instance.getAsks().N();
+  std::mt19937 gen(7);
+  std::vector<int> order(m);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), gen);
+  FreeAskIndex index(instance.getAsks(), order);
+  std::vector<bool> free(m, true);
+
+  // erase asks until few are left, then insert them again
+  std::uniform_int_distribution<int> ask(0, m - 1);
+  for (unsigned int step = 0; step < 4 * m; ++step) {
+    int j = ask(gen);
+    if (step < 2 * m) {
+      index.erase(j);
+      free[j] = false;
+    } else {
+      index.insert(j);
+      free[j] = true;
+    }
+    if (step % 10) continue;
+
+    CPPUNIT_ASSERT_EQUAL(
+        (unsigned int)std::count(free.begin(), free.end(), true),
+        index.size());
+    for (unsigned int i = 0; i < n; ++i) {
+      int expected = -1;
+      for (int k : order)
+        if (free[k] && instance.checkAllocate(i, k)) {
+          expected = k;
+          break;
+        }
+      CPPUNIT_ASSERT_EQUAL(expected, index.findFirst(instance.getBids(), i));
+    }
+  }
+}
@@ -0,0 +1,39 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_FREE_ASK_INDEX_H_
+#define TEST_TEST_FREE_ASK_INDEX_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+class TestFreeAskIndex : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestFreeAskIndex);
+  CPPUNIT_TEST(testReset);
+  CPPUNIT_TEST(testFindFirst);
+  CPPUNIT_TEST_SUITE_END();
+
+ protected:
+  // check that all asks are free after construction and reset
+  void testReset(void);
+  // check findFirst against a scan of the free asks in order after random
+  // erase and insert, for a number of asks that is not a power of 2
+  void testFindFirst(void);
+};
+
+#endif  // TEST_TEST_FREE_ASK_INDEX_H_
@@ -0,0 +1,156 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "test/test_greedy_evaluator.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "src/greedy_evaluator.h"
+#include "src/thread_pool.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestGreedyEvaluator);
+
+void TestGreedyEvaluator::setUp(void) {
+  auto copy = std::make_shared<Instance>("test/test_dataset_small");
+  copy->buildCompatibilityIndex();
+  instance = copy;
+}
+
+// Greedy allocation along an ordering, without checkpoints: each leader gets
+// the first compatible follower after the follower of the previous leader,
+// until a leader has none.
+// @param critical set to the position of the last allocated leader, or 0
+// @return the welfare
+double TestGreedyEvaluator::greedyWelfare(bool leaders_are_bids,
+                                          const std::vector<int> &leaders,
+                                          const std::vector<int> &followers,
+                                          unsigned int &critical) {
+  double welfare = 0.;
+  critical = 0;
+  unsigned int p = 0;
+  for (unsigned int k = 0; k < leaders.size(); ++k) {
+    int x = leaders[k];
+    while (p < followers.size() &&
+           !(leaders_are_bids ? instance->canAllocate(x, followers[p])
+                              : instance->canAllocate(followers[p], x)))
+      ++p;
+    if (p >= followers.size()) break;
+    int y = followers[p];
+    welfare += leaders_are_bids
+                   ? instance->getBids().V()[x] - instance->getAsks().V()[y]
+                   : instance->getBids().V()[y] - instance->getAsks().V()[x];
+    critical = k;
+    ++p;
+  }
+  return welfare;
+}
+
+// @return a random permutation of 0, ..., n-1
+std::vector<int> TestGreedyEvaluator::shuffled(unsigned int n,
+                                               unsigned int seed) {
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937 generator(seed);
+  std::shuffle(order.begin(), order.end(), generator);
+  return order;
+}
+
+void TestGreedyEvaluator::testCheckpoint(void) {
+  for (bool leaders_are_bids : {true, false}) {
+    unsigned int n = leaders_are_bids ? instance->getBids().N()
+                                      : instance->getAsks().N();
+    unsigned int m = leaders_are_bids ? instance->getAsks().N()
+                                      : instance->getBids().N();
+    std::vector<int> followers = shuffled(m, 1);
+    GreedyEvaluator evaluator(*instance, leaders_are_bids, followers);
+    for (unsigned int seed = 2; seed < 12; ++seed) {
+      std::vector<int> leaders = shuffled(n, seed);
+      unsigned int critical, expected_critical;
+      double welfare = evaluator.checkpoint(leaders, critical);
+      double expected = greedyWelfare(leaders_are_bids, leaders, followers,
+                                      expected_critical);
+      CPPUNIT_ASSERT(welfare == expected);
+      CPPUNIT_ASSERT_EQUAL(expected_critical, critical);
+    }
+  }
+}
+
+void TestGreedyEvaluator::testRotatedWelfare(void) {
+  for (bool leaders_are_bids : {true, false}) {
+    unsigned int n = leaders_are_bids ? instance->getBids().N()
+                                      : instance->getAsks().N();
+    unsigned int m = leaders_are_bids ? instance->getAsks().N()
+                                      : instance->getBids().N();
+    std::vector<int> followers = shuffled(m, 1);
+    std::vector<int> leaders = shuffled(n, 2);
+    GreedyEvaluator evaluator(*instance, leaders_are_bids, followers);
+    unsigned int critical;
+    evaluator.checkpoint(leaders, critical);
+    for (unsigned int first = 0; first < n; ++first) {
+      for (unsigned int last = first; last < n; ++last) {
+        std::vector<int> rotated = leaders;
+        GreedyEvaluator::rotate(rotated, first, last);
+        // the moved leaders come first, in reverse order
+        for (unsigned int k = first; k <= last; ++k)
+          CPPUNIT_ASSERT_EQUAL(leaders[k], rotated[last - k]);
+        // welfare is summed in the same order, so it is the same number
+        CPPUNIT_ASSERT(evaluator.rotatedWelfare(first, last) ==
+                       greedyWelfare(leaders_are_bids, rotated, followers,
+                                     critical));
+      }
+    }
+  }
+}
+
+void TestGreedyEvaluator::testFirstImprovement(void) {
+  ThreadPool sequential(0);
+  ThreadPool threads(3);
+  for (bool leaders_are_bids : {true, false}) {
+    unsigned int n = leaders_are_bids ? instance->getBids().N()
+                                      : instance->getAsks().N();
+    unsigned int m = leaders_are_bids ? instance->getAsks().N()
+                                      : instance->getBids().N();
+    std::vector<int> followers = shuffled(m, 1);
+    std::vector<int> leaders = shuffled(n, 2);
+    GreedyEvaluator evaluator(*instance, leaders_are_bids, followers);
+    unsigned int critical;
+    double welfare = evaluator.checkpoint(leaders, critical);
+    unsigned int num_improving = 0;
+    for (unsigned int first = 0; first < n; first += 7) {
+      unsigned int expected = first;
+      for (; expected < n; ++expected) {
+        std::vector<int> rotated = leaders;
+        GreedyEvaluator::rotate(rotated, first, expected);
+        if (greedyWelfare(leaders_are_bids, rotated, followers, critical) >
+            welfare)
+          break;
+      }
+      CPPUNIT_ASSERT_EQUAL(expected,
+                           evaluator.firstImprovement(first, welfare,
+                                                      sequential));
+      CPPUNIT_ASSERT_EQUAL(expected,
+                           evaluator.firstImprovement(first, welfare, threads));
+      if (expected < n) ++num_improving;
+    }
+    // a random ordering can be improved
+    CPPUNIT_ASSERT(num_improving > 0);
+  }
+}
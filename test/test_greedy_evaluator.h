@@ -0,0 +1,59 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef TEST_TEST_GREEDY_EVALUATOR_H_
+#define TEST_TEST_GREEDY_EVALUATOR_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+#include <vector>
+
+#include "src/instance.h"
+
+class TestGreedyEvaluator : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestGreedyEvaluator);
+  CPPUNIT_TEST(testCheckpoint);
+  CPPUNIT_TEST(testRotatedWelfare);
+  CPPUNIT_TEST(testFirstImprovement);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp(void);
+
+ protected:
+  // check the welfare and critical position of a checkpointed run against a
+  // full greedy run
+  void testCheckpoint(void);
+  // check that resuming the checkpoint gives the welfare of a full greedy
+  // run along each rotated ordering
+  void testRotatedWelfare(void);
+  // check the first improving move, sequentially and with threads, against
+  // full greedy runs
+  void testFirstImprovement(void);
+
+  double greedyWelfare(bool leaders_are_bids, const std::vector<int> &leaders,
+                       const std::vector<int> &followers,
+                       unsigned int &critical);
+  std::vector<int> shuffled(unsigned int n, unsigned int seed);
+
+  InstancePtr instance;
+};
+
+#endif  // TEST_TEST_GREEDY_EVALUATOR_H_
@@ -0,0 +1,125 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_instance_io.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/instance.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestInstanceIO);
+
+// asserts that two bid sets have the same values and quantities
+static void assertEqualBidSets(const BidSet &expected, const BidSet &actual) {
+  CPPUNIT_ASSERT_EQUAL(expected.N(), actual.N());
+  CPPUNIT_ASSERT_EQUAL(expected.L(), actual.L());
+  CPPUNIT_ASSERT_EQUAL(expected.S(), actual.S());
+  for (unsigned int i = 0; i < expected.N(); ++i) {
+    CPPUNIT_ASSERT_EQUAL(expected.V()[i], actual.V()[i]);
+    // the padding is written as well
+    for (unsigned int k = 0; k < expected.S(); ++k)
+      CPPUNIT_ASSERT_EQUAL(expected.row(i)[k], actual.row(i)[k]);
+  }
+}
+
+// asserts that a bid set has the values and quantities of a YAML node
+static void assertEqualBidSet(const YAML::Node &expected,
+                              const BidSet &actual) {
+  const YAML::Node &values = expected["values"];
+  const YAML::Node &quantities = expected["quantities"];
+  CPPUNIT_ASSERT_EQUAL((unsigned int)values.size(), actual.N());
+  CPPUNIT_ASSERT_EQUAL((unsigned int)quantities.size(), actual.N());
+  for (unsigned int i = 0; i < actual.N(); ++i) {
+    CPPUNIT_ASSERT_EQUAL(values[i].as<double>(), actual.V()[i]);
+    CPPUNIT_ASSERT_EQUAL((unsigned int)quantities[i].size(), actual.L());
+    for (unsigned int k = 0; k < actual.L(); ++k)
+      CPPUNIT_ASSERT_EQUAL(quantities[i][k].as<unsigned int>(),
+                           actual.row(i)[k]);
+    for (unsigned int k = actual.L(); k < actual.S(); ++k)
+      CPPUNIT_ASSERT_EQUAL(0u, actual.row(i)[k]);
+  }
+}
+
+// asserts that readAll returns the instances of the documents of a file
+static void assertEqualInstances(const std::string &filename) {
+  std::vector<YAML::Node> documents = YAML::LoadAllFromFile(filename);
+  unsigned int count = 0;
+  Instance::readAll(filename, [&](std::shared_ptr<Instance> read) {
+    CPPUNIT_ASSERT(count < documents.size());
+    assertEqualBidSet(documents[count]["bids"], read->getBids());
+    assertEqualBidSet(documents[count]["asks"], read->getAsks());
+    ++count;
+  });
+  CPPUNIT_ASSERT_EQUAL((unsigned int)documents.size(), count);
+}
+
+void TestInstanceIO::testBinaryRoundTrip(void) {
+  namespace fs = boost::filesystem;
+  Instance yaml("test/test_dataset_small");
+  CPPUNIT_ASSERT(yaml.getBids().N() > 0 && yaml.getAsks().N() > 0);
+  fs::path file = fs::temp_directory_path() / fs::unique_path();
+  yaml.writeBinary(file.string());
+  CPPUNIT_ASSERT(Instance::isBinaryFile(file.string()));
+  {
+    Instance binary(file.string());
+    assertEqualBidSets(yaml.getBids(), binary.getBids());
+    assertEqualBidSets(yaml.getAsks(), binary.getAsks());
+
+    // readAll handles a binary file as a single instance
+    unsigned int count = 0;
+    Instance::readAll(file.string(), [&](std::shared_ptr<Instance> read) {
+      ++count;
+      assertEqualBidSets(yaml.getBids(), read->getBids());
+      assertEqualBidSets(yaml.getAsks(), read->getAsks());
+    });
+    CPPUNIT_ASSERT_EQUAL(1u, count);
+  }
+  fs::remove(file);
+}
+
+void TestInstanceIO::testYamlReader(void) {
+  namespace fs = boost::filesystem;
+  assertEqualInstances("test/test_dataset_small");
+
+  fs::path file = fs::temp_directory_path() / fs::unique_path();
+  {
+    std::ofstream out(file.string());
+    out << "bids:\n"
+           "  values: [2.5, 1e-3, 7]\n"
+           "  metadata: {seed: 1, names: [a, b]}\n"
+           "  quantities:\n"
+           "  - [1, 2]\n"
+           "  - [0, 4]\n"
+           "  - [3, 0]\n"
+           "asks:\n"
+           "  quantities: [[5, 5]]\n"
+           "  values: [0.25]\n"
+           "params: {asks: {values: [9]}, bids: [[1, 2]]}\n"
+           "---\n"
+           "asks: {values: [1.5, 2], quantities: [[1], [2]]}\n"
+           "bids: {quantities: [[3]], values: [4]}\n";
+  }
+  assertEqualInstances(file.string());
+  fs::remove(file);
+}
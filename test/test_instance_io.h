@@ -0,0 +1,41 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_INSTANCE_IO_H_
+#define TEST_TEST_INSTANCE_IO_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+class TestInstanceIO : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestInstanceIO);
+  CPPUNIT_TEST(testBinaryRoundTrip);
+  CPPUNIT_TEST(testYamlReader);
+  CPPUNIT_TEST_SUITE_END();
+
+ protected:
+  // check that an instance read from YAML, written with writeBinary and read
+  // back has the same bids and asks
+  void testBinaryRoundTrip(void);
+  // check the instances of YamlInstanceReader against a read of the same
+  // file into YAML::Node trees, for the test dataset and for a file of
+  // several documents with other key orders and keys to skip
+  void testYamlReader(void);
+};
+
+#endif  // TEST_TEST_INSTANCE_IO_H_
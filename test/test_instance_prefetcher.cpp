@@ -0,0 +1,111 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_instance_prefetcher.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestInstancePrefetcher);
+
+void TestInstancePrefetcher::setUp(void) {
+  instance = std::make_shared<Instance>("test/test_dataset_small");
+  loaded = 0;
+}
+
+InstancePrefetcher::Loader TestInstancePrefetcher::loaderOf(
+    unsigned int documents) {
+  return [this, documents](
+             std::string infile,
+             std::function<void(InstancePtr, std::string)> handle) {
+    if (infile == "missing") throw std::runtime_error("cannot read file");
+    for (unsigned int k = 0; k < documents; ++k) {
+      handle(instance, infile + "/" + std::to_string(k));
+      ++loaded;
+    }
+  };
+}
+
+unsigned int TestInstancePrefetcher::consume(
+    InstancePrefetcher &prefetcher, const std::vector<std::string> &names) {
+  unsigned int most = 0;
+  InstancePtr next;
+  std::string name;
+  for (unsigned int k = 0; k < names.size(); ++k) {
+    // give the loaders time to fill the queue
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    most = std::max(most, loaded - k);
+    CPPUNIT_ASSERT(prefetcher.next(next, name));
+    CPPUNIT_ASSERT_EQUAL(names[k], name);
+    CPPUNIT_ASSERT(next == instance);
+  }
+  CPPUNIT_ASSERT(!prefetcher.next(next, name));
+  return most;
+}
+
+void TestInstancePrefetcher::testOrder(void) {
+  std::vector<std::string> infiles = {"a", "b", "c", "d"}, names;
+  for (auto &infile : infiles)
+    for (unsigned int k = 0; k < 3; ++k)
+      names.push_back(infile + "/" + std::to_string(k));
+  for (unsigned int depth : {1u, 2u, 8u}) {
+    loaded = 0;
+    InstancePrefetcher prefetcher(infiles, loaderOf(3), depth, 1ul << 40);
+    // the current file may queue one more instance once it has none queued
+    CPPUNIT_ASSERT(consume(prefetcher, names) <= depth + 1);
+  }
+}
+
+void TestInstancePrefetcher::testDepth(void) {
+  std::vector<std::string> names;
+  for (unsigned int k = 0; k < 10; ++k)
+    names.push_back("a/" + std::to_string(k));
+  InstancePrefetcher prefetcher({"a"}, loaderOf(10), 3, 1ul << 40);
+  CPPUNIT_ASSERT_EQUAL(3u, consume(prefetcher, names));
+}
+
+void TestInstancePrefetcher::testMemory(void) {
+  std::vector<std::string> names;
+  for (unsigned int k = 0; k < 10; ++k)
+    names.push_back("a/" + std::to_string(k));
+  std::size_t bytes = instance->memoryUsage();
+  InstancePrefetcher prefetcher({"a"}, loaderOf(10), 8, 2 * bytes + bytes / 2);
+  CPPUNIT_ASSERT_EQUAL(2u, consume(prefetcher, names));
+
+  // an instance above the cap is let through alone
+  loaded = 0;
+  InstancePrefetcher small({"a"}, loaderOf(10), 8, bytes / 2);
+  CPPUNIT_ASSERT_EQUAL(1u, consume(small, names));
+}
+
+void TestInstancePrefetcher::testError(void) {
+  InstancePrefetcher prefetcher({"a", "missing", "b"}, loaderOf(2), 2,
+                                1ul << 40);
+  InstancePtr next;
+  std::string name;
+  CPPUNIT_ASSERT(prefetcher.next(next, name));
+  CPPUNIT_ASSERT_EQUAL(std::string("a/0"), name);
+  CPPUNIT_ASSERT(prefetcher.next(next, name));
+  CPPUNIT_ASSERT_EQUAL(std::string("a/1"), name);
+  CPPUNIT_ASSERT_THROW(prefetcher.next(next, name), std::runtime_error);
+  // the files after it are still returned
+  CPPUNIT_ASSERT(prefetcher.next(next, name));
+  CPPUNIT_ASSERT_EQUAL(std::string("b/0"), name);
+}
@@ -0,0 +1,65 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_INSTANCE_PREFETCHER_H_
+#define TEST_TEST_INSTANCE_PREFETCHER_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "src/instance_prefetcher.h"
+
+class TestInstancePrefetcher : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestInstancePrefetcher);
+  CPPUNIT_TEST(testOrder);
+  CPPUNIT_TEST(testDepth);
+  CPPUNIT_TEST(testMemory);
+  CPPUNIT_TEST(testError);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp(void);
+
+ protected:
+  // check that the instances come in the order of the files and documents
+  void testOrder(void);
+  // check that at most depth instances of a multi-document file are loaded
+  // ahead of the consumer
+  void testDepth(void);
+  // check that the memory cap limits the instances loaded ahead
+  void testMemory(void);
+  // check that the error of a file is rethrown after the instances before it
+  void testError(void);
+
+  // a loader passing on documents instances per file, named "file/k", that
+  // counts the instances passed on
+  InstancePrefetcher::Loader loaderOf(unsigned int documents);
+  // @return the most instances loaded ahead while the instances of the
+  // prefetcher are taken slowly, all of them in the given order
+  unsigned int consume(InstancePrefetcher &prefetcher,
+                       const std::vector<std::string> &names);
+
+  InstancePtr instance;
+  std::atomic<unsigned int> loaded;
+};
+
+#endif  // TEST_TEST_INSTANCE_PREFETCHER_H_
@@ -0,0 +1,72 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "test/test_minimum_tree.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "src/minimum_tree.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMinimumTree);
+
+void TestMinimumTree::testEmpty(void) {
+  for (unsigned int n : {1u, 5u, 64u}) {
+    MinimumTree tree(n);
+    for (unsigned int p = 0; p <= n; ++p)
+      CPPUNIT_ASSERT_EQUAL(n, tree.firstBelow(p, 1.e300));
+  }
+}
+
+void TestMinimumTree::testLastPosition(void) {
+  for (unsigned int n : {1u, 3u, 5u, 63u, 65u, 100u}) {
+    MinimumTree tree(n);
+    tree.set(n - 1, 1.);
+    CPPUNIT_ASSERT_EQUAL(n - 1, tree.firstBelow(0, 2.));
+    CPPUNIT_ASSERT_EQUAL(n - 1, tree.firstBelow(n - 1, 2.));
+    CPPUNIT_ASSERT_EQUAL(n, tree.firstBelow(n - 1, 1.));
+    CPPUNIT_ASSERT_EQUAL(n, tree.firstBelow(n, 2.));
+  }
+}
+
+void TestMinimumTree::testFirstBelow(void) {
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> value(0., 10.);
+  for (unsigned int n : {1u, 5u, 63u, 64u, 65u, 100u, 500u}) {
+    MinimumTree tree(n);
+    std::vector<double> values(n, std::numeric_limits<double>::infinity());
+    std::uniform_int_distribution<unsigned int> position(0, n - 1);
+    for (unsigned int step = 0; step < 2 * n; ++step) {
+      unsigned int q = position(generator);
+      // some positions become infinite again, as unallocated asks do
+      values[q] =
+          step % 5 ? value(generator) : std::numeric_limits<double>::infinity();
+      tree.set(q, values[q]);
+
+      double bound = value(generator);
+      for (unsigned int p = 0; p <= n; ++p) {
+        // the first position at or after p below the bound, found by a scan
+        unsigned int first = p;
+        while (first < n && values[first] >= bound) ++first;
+        CPPUNIT_ASSERT_EQUAL(first, tree.firstBelow(p, bound));
+      }
+    }
+  }
+}
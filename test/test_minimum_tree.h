@@ -0,0 +1,42 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#ifndef TEST_TEST_MINIMUM_TREE_H_
+#define TEST_TEST_MINIMUM_TREE_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+class TestMinimumTree : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestMinimumTree);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testLastPosition);
+  CPPUNIT_TEST(testFirstBelow);
+  CPPUNIT_TEST_SUITE_END();
+
+ protected:
+  // check that no position is found while all values are infinite
+  void testEmpty(void);
+  // check a value at position n-1, for sizes that are not powers of 2
+  void testLastPosition(void);
+  // check firstBelow against a scan of the values after random updates
+  void testFirstBelow(void);
+};
+
+#endif  // TEST_TEST_MINIMUM_TREE_H_
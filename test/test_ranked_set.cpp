@@ -0,0 +1,67 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+
+#include "test/test_ranked_set.h"
+
+#include <cppunit/TestAssert.h>
+
+#include <random>
+#include <vector>
+
+#include "src/ranked_set.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRankedSet);
+
+void TestRankedSet::testFill(void) {
+  for (unsigned int n : {1u, 2u, 7u, 64u, 100u}) {
+    RankedSet set(n);
+    CPPUNIT_ASSERT_EQUAL(0u, set.size());
+    set.fill();
+    CPPUNIT_ASSERT_EQUAL(n, set.size());
+    for (unsigned int r = 0; r < n; ++r) {
+      CPPUNIT_ASSERT(set.contains(r));
+      CPPUNIT_ASSERT_EQUAL(r, set.select(r));
+    }
+  }
+}
+
+void TestRankedSet::testSelect(void) {
+  std::mt19937 generator(1);
+  for (unsigned int n : {1u, 5u, 63u, 64u, 65u, 100u, 1000u}) {
+    RankedSet set(n);
+    std::vector<bool> member(n, false);
+    std::uniform_int_distribution<unsigned int> position(0, n - 1);
+    for (unsigned int step = 0; step < 4 * n; ++step) {
+      unsigned int p = position(generator);
+      if (member[p])
+        set.erase(p);
+      else
+        set.insert(p);
+      member[p] = !member[p];
+
+      // the members in order, as found by a scan
+      std::vector<unsigned int> members;
+      for (unsigned int q = 0; q < n; ++q)
+        if (member[q]) members.push_back(q);
+      CPPUNIT_ASSERT_EQUAL((unsigned int)members.size(), set.size());
+      for (unsigned int r = 0; r < members.size(); ++r)
+        CPPUNIT_ASSERT_EQUAL(members[r], set.select(r));
+      for (unsigned int q = 0; q < n; ++q)
+        CPPUNIT_ASSERT_EQUAL(bool(member[q]), set.contains(q));
+    }
+  }
+}
@@ -0,0 +1,126 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#include "test/test_stats_writer.h"
+
+#include <cppunit/TestAssert.h>
+#include <sys/stat.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/stats_writer.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestStatsWriter);
+
+namespace {
+
+const unsigned int num_threads = 4;
+const unsigned int rows_per_thread = 500;
+
+// row r of thread t
+std::string row(unsigned int t, unsigned int r) {
+  return std::to_string(t) + "," + std::to_string(r) + "\n";
+}
+
+// queues the rows of all threads, without waiting for a flush
+void writeRows(StatsWriter &writer) {
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < num_threads; ++t)
+    threads.emplace_back([&writer, t]() {
+      for (unsigned int r = 0; r < rows_per_thread; ++r)
+        writer.write(row(t, r));
+    });
+  for (auto &thread : threads) thread.join();
+}
+
+// asserts that lines has the rows of all threads, each thread in order,
+// starting at line first
+void assertRows(const std::vector<std::string> &lines, std::size_t first) {
+  CPPUNIT_ASSERT_EQUAL(first + num_threads * rows_per_thread, lines.size());
+  std::vector<unsigned int> next(num_threads, 0);
+  for (std::size_t i = first; i < lines.size(); ++i) {
+    unsigned int t = std::stoul(lines[i].substr(0, lines[i].find(',')));
+    CPPUNIT_ASSERT(t < num_threads);
+    CPPUNIT_ASSERT_EQUAL(row(t, next[t]++), lines[i] + "\n");
+  }
+}
+
+std::vector<std::string> readLines(std::istream &in) {
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(in, line)) lines.push_back(line);
+  return lines;
+}
+
+}  // namespace
+
+void TestStatsWriter::testFlushOnDestruction(void) {
+  namespace fs = boost::filesystem;
+  fs::path file = fs::temp_directory_path() / fs::unique_path();
+  {
+    StatsWriter writer(file.string(), "header");
+    writeRows(writer);
+  }
+  {
+    std::ifstream in(file.string());
+    std::vector<std::string> lines = readLines(in);
+    CPPUNIT_ASSERT(!lines.empty());
+    CPPUNIT_ASSERT_EQUAL(std::string("header"), lines[0]);
+    assertRows(lines, 1);
+  }
+
+  // rows are appended to an existing file, without a second header
+  {
+    StatsWriter writer(file.string(), "header");
+    writer.write(row(0, rows_per_thread));
+  }
+  std::ifstream in(file.string());
+  std::vector<std::string> lines = readLines(in);
+  CPPUNIT_ASSERT_EQUAL((std::size_t)2 + num_threads * rows_per_thread,
+                       lines.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("header"), lines[0]);
+  CPPUNIT_ASSERT_EQUAL(row(0, rows_per_thread), lines.back() + "\n");
+  fs::remove(file);
+}
+
+void TestStatsWriter::testPipe(void) {
+  namespace fs = boost::filesystem;
+  fs::path fifo = fs::temp_directory_path() / fs::unique_path();
+  CPPUNIT_ASSERT_EQUAL(0, mkfifo(fifo.c_str(), 0600));
+  // opening the FIFO for writing blocks until it is opened for reading
+  std::ostringstream received;
+  std::thread reader([&fifo, &received]() {
+    std::ifstream in(fifo.string());
+    received << in.rdbuf();
+  });
+  {
+    StatsWriter writer(fifo.string(), "header");
+    writeRows(writer);
+  }
+  reader.join();
+  fs::remove(fifo);
+
+  std::istringstream in(received.str());
+  std::vector<std::string> lines = readLines(in);
+  CPPUNIT_ASSERT(!lines.empty());
+  CPPUNIT_ASSERT_EQUAL(std::string("header"), lines[0]);
+  assertRows(lines, 1);
+}
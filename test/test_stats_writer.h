@@ -0,0 +1,40 @@
+// --------------------------------------------------------------------------
+// Copyright (C) Karlsruhe Institute of Technology, 2019
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// --------------------------------------------------------------------------
+#ifndef TEST_TEST_STATS_WRITER_H_
+#define TEST_TEST_STATS_WRITER_H_
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+class TestStatsWriter : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestStatsWriter);
+  CPPUNIT_TEST(testFlushOnDestruction);
+  CPPUNIT_TEST(testPipe);
+  CPPUNIT_TEST_SUITE_END();
+
+ protected:
+  // check that rows queued by several threads are all written when the
+  // writer is destroyed, and that the header is only written to a new file
+  void testFlushOnDestruction(void);
+  // check that rows are written to an output that cannot seek (a FIFO),
+  // with the header
+  void testPipe(void);
+};
+
+#endif  // TEST_TEST_STATS_WRITER_H_